@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cstring>
 #include <cstdlib>
+#include <cstdint>
 #include <ctime>
 
 using namespace std;
@@ -459,9 +460,9 @@ struct API::op_Arg5
 		unsigned int** param1 = &this->param1;
 		unsigned int*** param2 = &this->param2;
 
-		*param1 = (unsigned int*)((unsigned) &param1_reftext - (unsigned) &unk1);
-		*param2 = (unsigned int**)((unsigned) &param2_real - (unsigned) &unk1);
-		param2_real = (unsigned int*)((unsigned) &param2_reftext - (unsigned) &unk1);
+		*param1 = (unsigned int*)(reinterpret_cast<uintptr_t>(&param1_reftext) - reinterpret_cast<uintptr_t>(&unk1));
+		*param2 = (unsigned int**)(reinterpret_cast<uintptr_t>(&param2_real) - reinterpret_cast<uintptr_t>(&unk1));
+		param2_real = (unsigned int*)(reinterpret_cast<uintptr_t>(&param2_reftext) - reinterpret_cast<uintptr_t>(&unk1));
 	}
 };
 
@@ -268,7 +268,8 @@ Lockable* Actor::SetActorDead(bool state, unsigned short limbs, signed char caus
 #ifdef VAULTSERVER
 Lockable* Actor::SetBase(unsigned int baseID)
 {
-	const DB::Record* record = *DB::Record::Lookup(baseID, vector<string>{"NPC_", "CREA"});
+	constexpr unsigned int types = DB::Record::Mask("NPC_", "CREA");
+	const DB::Record* record = *DB::Record::Lookup(baseID, types);
 
 	if (this->GetName().empty())
 		this->SetName(record->GetDescription());
@@ -1,5 +1,10 @@
 #include "GameFactory.hpp"
 
+#ifdef VAULTSERVER
+#include <future>
+#include <thread>
+#endif
+
 using namespace std;
 using namespace RakNet;
 
@@ -30,17 +35,29 @@ Database<DB::AcReference> GameFactory::dbAcReferences;
 void GameFactory::Initialize()
 {
 #ifdef VAULTSERVER
-	dbRecords.initialize(DB_FALLOUT3, {"CONT", "NPC_", "CREA", "LVLI", "ALCH", "AMMO", "ARMA", "ARMO", "BOOK", "ENCH", "KEYM", "MISC", "NOTE", "WEAP", "CELL", "IDLE", "WTHR", "STAT", "MSTT", "RACE", "LIGH", "DOOR", "TERM", "EXPL", "PROJ", "STAT", "SOUN"});
-	dbExteriors.initialize(DB_FALLOUT3, {"exteriors"});
-	dbWeapons.initialize(DB_FALLOUT3, {"weapons"});
-	dbRaces.initialize(DB_FALLOUT3, {"races"});
-	dbNpcs.initialize(DB_FALLOUT3, {"npcs"});
-	dbContainers.initialize(DB_FALLOUT3, {"npcitems", "contitems"});
-	dbItems.initialize(DB_FALLOUT3, {"items"});
-	dbTerminals.initialize(DB_FALLOUT3, {"terminals"});
-	dbInteriors.initialize(DB_FALLOUT3, {"interiors"});
-	dbAcReferences.initialize(DB_FALLOUT3, {"arefs", "crefs"});
-	dbReferences.initialize(DB_FALLOUT3, {"refs_CONT", "refs_DOOR", "refs_TERM", "refs_STAT"});
+	// every database fills only its own indexes, each load has its own connection. containers look up records and references look up exteriors while loading
+	// with a single hardware thread the loads only contend, they are deferred and run one after another in the order they are waited for
+	auto policy = thread::hardware_concurrency() > 1 ? launch::async : launch::deferred;
+	shared_future<void> records = async(policy, []() { dbRecords.initialize(DB_FALLOUT3, {"CONT", "NPC_", "CREA", "LVLI", "ALCH", "AMMO", "ARMA", "ARMO", "BOOK", "ENCH", "KEYM", "MISC", "NOTE", "WEAP", "CELL", "IDLE", "WTHR", "STAT", "MSTT", "RACE", "LIGH", "DOOR", "TERM", "EXPL", "PROJ", "STAT", "SOUN"}); }).share();
+	shared_future<void> exteriors = async(policy, []() { dbExteriors.initialize(DB_FALLOUT3, {"exteriors"}); }).share();
+
+	future<void> loads[] = {
+		async(policy, []() { dbWeapons.initialize(DB_FALLOUT3, {"weapons"}); }),
+		async(policy, []() { dbRaces.initialize(DB_FALLOUT3, {"races"}); }),
+		async(policy, []() { dbNpcs.initialize(DB_FALLOUT3, {"npcs"}); DB::NPC::ResolveTemplates(); }),
+		async(policy, [records]() { records.get(); dbContainers.initialize(DB_FALLOUT3, {"npcitems", "contitems"}); DB::BaseContainer::Index(); }),
+		async(policy, []() { dbItems.initialize(DB_FALLOUT3, {"items"}); }),
+		async(policy, []() { dbTerminals.initialize(DB_FALLOUT3, {"terminals"}); }),
+		async(policy, []() { dbInteriors.initialize(DB_FALLOUT3, {"interiors"}); }),
+		async(policy, []() { dbAcReferences.initialize(DB_FALLOUT3, {"arefs", "crefs"}); }),
+		async(policy, [exteriors]() { exteriors.get(); dbReferences.initialize(DB_FALLOUT3, {"refs_CONT", "refs_DOOR", "refs_TERM", "refs_STAT"}); DB::Reference::Index(); }),
+	};
+
+	records.get();
+	exteriors.get();
+
+	for (auto& load : loads)
+		load.get();
 #endif
 }
 
@@ -58,10 +75,35 @@ vector<NetworkID> GameFactory::GetByType(unsigned int type) noexcept
 	});
 }
 
+unsigned int GameFactory::GetByType(unsigned int type, NetworkID* data, unsigned int size) noexcept
+{
+	return cs.Operate([type, data, size]() {
+		unsigned int count = 0;
+
+		for (const auto& reference : instances)
+			if (reference.second & type)
+			{
+				if (count < size)
+					data[count] = reference.first->GetNetworkID();
+
+				++count;
+			}
+
+		return count;
+	});
+}
+
 unsigned int GameFactory::GetCount(unsigned int type) noexcept
 {
 	return cs.Operate([type]() {
-		return typecount[type];
+		unsigned int count = 0;
+
+		// every type is a single bit, a mask counts the types it contains as GetByType matches them
+		for (const auto& types : typecount)
+			if (types.first & type)
+				count += types.second;
+
+		return count;
 	});
 }
 
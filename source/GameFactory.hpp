@@ -26,6 +26,7 @@
 #include "Debug.hpp"
 #endif
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <unordered_set>
@@ -250,7 +251,11 @@ class GameFactory
 		 */
 		static std::vector<RakNet::NetworkID> GetByType(unsigned int type) noexcept;
 		/**
-		 * \brief Counts the amount of Bases of a given type
+		 * \brief Copies at most size NetworkID's of all Bases of a given type into data and returns their amount
+		 */
+		static unsigned int GetByType(unsigned int type, RakNet::NetworkID* data, unsigned int size) noexcept;
+		/**
+		 * \brief Counts the amount of Bases of a given type or mask of types
 		 */
 		static unsigned int GetCount(unsigned int type) noexcept;
 		/**
@@ -263,6 +268,11 @@ class GameFactory
 		 */
 		template<typename T, FailPolicy FP, typename... Args>
 		static auto Create(Args&&... args) { return Create_<T, FP, Args...>::Create(std::forward<Args>(args)...); }
+		/**
+		 * \brief Creates one instance of a given type per argument, all instances are registered under a single lock
+		 */
+		template<typename T, typename A>
+		static std::vector<RakNet::NetworkID> CreateAll(const std::vector<A>& args);
 
 		/**
 		 * \brief Destroys all instances and cleans up type classes
@@ -307,7 +317,8 @@ struct GameFactory::Get_<T, RakNet::NetworkID> {
 	static auto Get(const C<RakNet::NetworkID>& ids) noexcept
 	{
 		std::vector<Expected<FactoryWrapper<T>>> result(ids.size());
-		std::multimap<BaseList::value_type, unsigned int> sort;
+		std::vector<std::pair<std::pair<BaseList::key_type, BaseList::mapped_type>, unsigned int>> sort;
+		sort.reserve(ids.size());
 
 		cs.Operate([&ids, &result, &sort]() {
 			unsigned int i = 0;
@@ -319,12 +330,15 @@ struct GameFactory::Get_<T, RakNet::NetworkID> {
 				if (it == instances.end())
 					result[i] = VaultException("Unknown object with NetworkID %llu", id);
 				else
-					sort.emplace(*it, i);
+					sort.emplace_back(*it, i);
 
 				++i;
 			}
 		});
 
+		// objects are locked in the order of their addresses, so that batches over the same objects can't deadlock
+		std::sort(sort.begin(), sort.end(), [](const auto& a, const auto& b) { return a.first.first < b.first.first; });
+
 		for (const auto& base : sort)
 			result[base.second] = FactoryWrapper<T>(base.first.first.get(), base.first.second);
 
@@ -422,6 +436,38 @@ struct GameFactory::Create_<T, FailPolicy::Exception, Args...> {
 	}
 };
 
+template<typename T, typename A>
+std::vector<RakNet::NetworkID> GameFactory::CreateAll(const std::vector<A>& args)
+{
+	static_assert(std::is_base_of<Base, T>::value, "T must be derived from Base");
+
+	std::vector<std::shared_ptr<Base>> bases;
+	std::vector<RakNet::NetworkID> ids;
+	constexpr unsigned int type = rTypes<T>::value;
+
+	bases.reserve(args.size());
+	ids.reserve(args.size());
+
+	for (const auto& arg : args)
+	{
+		bases.emplace_back(new T(arg));
+		ids.emplace_back(bases.back()->GetNetworkID());
+
+	#ifdef VAULTSERVER
+		bases.back()->initializers();
+	#endif
+	}
+
+	cs.Operate([&bases, &ids, type]() {
+		typecount[type] += bases.size();
+
+		for (std::size_t i = 0; i < bases.size(); ++i)
+			index[ids[i]] = instances.emplace(std::move(bases[i]), type).first;
+	});
+
+	return ids;
+}
+
 template<typename T, typename... Args>
 struct GameFactory::Create_<T, FailPolicy::Return, Args...> {
 	static RakNet::NetworkID Create(Args&&... args)
@@ -104,7 +104,8 @@ Lockable* Item::SetItemStick(bool stick)
 #ifdef VAULTSERVER
 Lockable* Item::SetBase(unsigned int baseID)
 {
-	const DB::Record* record = *DB::Record::Lookup(baseID, vector<string>{"ALCH", "AMMO", "ARMA", "ARMO", "BOOK", "ENCH", "KEYM", "MISC", "NOTE", "WEAP", "LIGH"});
+	constexpr unsigned int types = DB::Record::Mask("ALCH", "AMMO", "ARMA", "ARMO", "BOOK", "ENCH", "KEYM", "MISC", "NOTE", "WEAP", "LIGH");
+	const DB::Record* record = *DB::Record::Lookup(baseID, types);
 
 	if (this->GetName().empty())
 		this->SetName(record->GetDescription());
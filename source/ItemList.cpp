@@ -3,6 +3,7 @@
 #include "Item.hpp"
 
 #include <algorithm>
+#include <unordered_set>
 
 using namespace std;
 using namespace RakNet;
@@ -49,15 +50,37 @@ void ItemList::initialize()
 
 NetworkID ItemList::FindStackableItem(unsigned int baseID, float condition) const
 {
-	for (NetworkID id : container)
-		if (GameFactory::Operate<Item>(id, [baseID, condition](Item* item) {
-			return item->GetBase() == baseID && Utils::DoubleCompare(item->GetItemCondition(), condition, CONDITION_EPS);
+	auto it = bases.find(baseID);
+
+	if (it == bases.end())
+		return 0;
+
+	for (NetworkID id : it->second)
+		if (GameFactory::Operate<Item>(id, [condition](Item* item) {
+			return Utils::DoubleCompare(item->GetItemCondition(), condition, CONDITION_EPS);
 		}))
 			return id;
 
 	return 0;
 }
 
+void ItemList::Insert(NetworkID id, unsigned int baseID)
+{
+	container.emplace_back(id);
+	bases[baseID].emplace_back(id);
+}
+
+void ItemList::Erase(NetworkID id, unsigned int baseID)
+{
+	container.erase(find(container.begin(), container.end(), id));
+
+	auto it = bases.find(baseID);
+	it->second.erase(find(it->second.begin(), it->second.end(), id));
+
+	if (it->second.empty())
+		bases.erase(it);
+}
+
 NetworkID ItemList::AddItem(NetworkID id)
 {
 	auto data = GameFactory::Operate<Item>(id, [this, id](Item* item) {
@@ -68,7 +91,7 @@ NetworkID ItemList::AddItem(NetworkID id)
 			// Alternative code path if the item has been received over network
 			if (container == this->GetNetworkID() && find(this->container.begin(), this->container.end(), id) == this->container.end())
 			{
-				this->container.emplace_back(id);
+				this->Insert(id, item->GetBase());
 				return make_pair(0u, 0.0f);
 			}
 
@@ -104,7 +127,7 @@ NetworkID ItemList::AddItem(NetworkID id)
 			item->SetItemContainer(this->GetNetworkID());
 		});
 
-		container.emplace_back(id);
+		Insert(id, data.first);
 	}
 
 	return stackable ? stackable : id;
@@ -141,55 +164,117 @@ ItemList::AddOp ItemList::AddItem(unsigned int baseID, unsigned int count, float
 			item->SetItemContainer(this->GetNetworkID());
 		});
 
-		container.emplace_back(result.second);
+		Insert(result.second, baseID);
 	}
 
 	return result;
 }
 
-void ItemList::RemoveItem(NetworkID id)
+ItemList::AddItemsOp ItemList::AddItems(const Entries& entries, bool silent)
 {
-	auto it = find(container.begin(), container.end(), id);
+	AddItemsOp result;
+	Entries stacks, created;
+
+	for (const auto& entry : entries)
+	{
+		if (!get<1>(entry))
+			continue;
+
+		auto it = find_if(stacks.begin(), stacks.end(), [&entry](const Entry& stack) {
+			return get<0>(stack) == get<0>(entry) && Utils::DoubleCompare(get<2>(stack), get<2>(entry), CONDITION_EPS);
+		});
+
+		if (it != stacks.end())
+			get<1>(*it) += get<1>(entry);
+		else
+			stacks.emplace_back(entry);
+	}
+
+	if (stacks.empty())
+		return result;
+
+	for (const auto& stack : stacks)
+	{
+		NetworkID stackable = FindStackableItem(get<0>(stack), get<2>(stack));
+
+		if (stackable)
+			GameFactory::Operate<Item>(stackable, [&result, &stack, stackable, silent](Item* item) {
+				item->SetItemCount(item->GetItemCount() + get<1>(stack));
+				item->SetItemSilent(silent);
+				result.second.emplace_back(stackable, item->GetItemCount());
+			});
+		else
+			created.emplace_back(stack);
+	}
+
+	if (created.empty())
+		return result;
+
+	vector<unsigned int> baseIDs;
+	baseIDs.reserve(created.size());
+
+	for (const auto& stack : created)
+		baseIDs.emplace_back(get<0>(stack));
+
+	result.first = GameFactory::CreateAll<Item>(baseIDs);
+
+	GameFactory::Operate<Item>(result.first, [this, &created, silent](Items& items) {
+		for (size_t i = 0; i < items.size(); ++i)
+		{
+			items[i]->SetItemCount(get<1>(created[i]));
+			items[i]->SetItemCondition(get<2>(created[i]));
+			items[i]->SetItemSilent(silent);
+			items[i]->SetItemContainer(this->GetNetworkID());
+		}
+	});
+
+	for (size_t i = 0; i < created.size(); ++i)
+		Insert(result.first[i], get<0>(created[i]));
 
-	if (it == container.end())
+	return result;
+}
+
+void ItemList::RemoveItem(NetworkID id)
+{
+	if (find(container.begin(), container.end(), id) == container.end())
 		throw VaultException("Unknown Item with NetworkID %llu in ItemList", id).stacktrace();
 
-	GameFactory::Operate<Item>(id, [](Item* item) {
+	unsigned int baseID = GameFactory::Operate<Item>(id, [](Item* item) {
 		item->SetItemContainer(0);
+		return item->GetBase();
 	});
 
-	container.erase(it);
+	Erase(id, baseID);
 }
 
 ItemList::RemoveOp ItemList::RemoveItem(unsigned int baseID, unsigned int count, bool silent)
 {
 	RemoveOp result;
 	unsigned int count_ = count;
+	auto it = bases.find(baseID);
 
-	for (NetworkID id : container)
-	{
-		if (!count)
-			break;
-		else
-			GameFactory::Operate<Item>(id, [&result, id, baseID, &count, silent](Item* item) {
-				if (item->GetBase() != baseID)
-					return;
-
-				if (item->GetItemCount() > count)
-				{
-					item->SetItemCount(item->GetItemCount() - count);
-					item->SetItemSilent(silent);
-					get<2>(result) = id;
-					count = 0;
-				}
-				else
-				{
-					get<1>(result).emplace_back(id);
-					item->SetItemSilent(silent);
-					count -= item->GetItemCount();
-				}
-			});
-	}
+	if (it != bases.end())
+		for (NetworkID id : it->second)
+		{
+			if (!count)
+				break;
+			else
+				GameFactory::Operate<Item>(id, [&result, id, &count, silent](Item* item) {
+					if (item->GetItemCount() > count)
+					{
+						item->SetItemCount(item->GetItemCount() - count);
+						item->SetItemSilent(silent);
+						get<2>(result) = id;
+						count = 0;
+					}
+					else
+					{
+						get<1>(result).emplace_back(id);
+						item->SetItemSilent(silent);
+						count -= item->GetItemCount();
+					}
+				});
+		}
 
 	get<0>(result) = count_ - count;
 
@@ -198,22 +283,20 @@ ItemList::RemoveOp ItemList::RemoveItem(unsigned int baseID, unsigned int count,
 
 NetworkID ItemList::EquipItem(unsigned int baseID, bool silent, bool stick) const
 {
-	NetworkID result = 0;
+	auto it = bases.find(baseID);
 
-	if (!IsEquipped(baseID))
-		for (NetworkID id : container)
-			if (GameFactory::Operate<Item>(id, [id, baseID, silent, stick](Item* item) {
-				if (item->GetBase() != baseID)
-					return 0ull;
+	if (it == bases.end() || IsEquipped(baseID))
+		return 0;
 
-				item->SetItemEquipped(true);
-				item->SetItemSilent(silent);
-				item->SetItemStick(stick);
-				return id;
-			}))
-				return id;
+	NetworkID id = it->second.front();
 
-	return result;
+	GameFactory::Operate<Item>(id, [silent, stick](Item* item) {
+		item->SetItemEquipped(true);
+		item->SetItemSilent(silent);
+		item->SetItemStick(stick);
+	});
+
+	return id;
 }
 
 NetworkID ItemList::UnequipItem(unsigned int baseID, bool silent, bool stick) const
@@ -232,9 +315,14 @@ NetworkID ItemList::UnequipItem(unsigned int baseID, bool silent, bool stick) co
 
 NetworkID ItemList::IsEquipped(unsigned int baseID) const
 {
-	for (NetworkID id : container)
-		if (GameFactory::Operate<Item>(id, [baseID](Item* item) {
-			return item->GetBase() == baseID && item->GetItemEquipped();
+	auto it = bases.find(baseID);
+
+	if (it == bases.end())
+		return 0;
+
+	for (NetworkID id : it->second)
+		if (GameFactory::Operate<Item>(id, [](Item* item) {
+			return item->GetItemEquipped();
 		}))
 			return id;
 
@@ -244,26 +332,43 @@ NetworkID ItemList::IsEquipped(unsigned int baseID) const
 unsigned int ItemList::GetItemCount(unsigned int baseID) const
 {
 	unsigned int count = 0;
+	const Impl* items = &container;
 
-	for (NetworkID id : container)
-		GameFactory::Operate<Item>(id, [&count, baseID](Item* item) {
-			if (!baseID || item->GetBase() == baseID)
-				count += item->GetItemCount();
+	if (baseID)
+	{
+		auto it = bases.find(baseID);
+
+		if (it == bases.end())
+			return 0;
+
+		items = &it->second;
+	}
+
+	for (NetworkID id : *items)
+		GameFactory::Operate<Item>(id, [&count](Item* item) {
+			count += item->GetItemCount();
 		});
 
 	return count;
 }
 
 #ifdef VAULTSERVER
-ItemList::Impl ItemList::GetItemTypes(const string& type) const
+ItemList::Impl ItemList::GetItemTypes(const char* type) const
 {
 	Impl result;
+	unordered_set<NetworkID> matching;
 
-	for (NetworkID id : container)
-		GameFactory::Operate<Item>(id, [&result, &type, id](Item* item) {
-			if (DB::Record::Lookup(item->GetBase(), type))
-				result.emplace_back(id);
-		});
+	// the type is a property of the base, so no item needs to be locked
+	for (const auto& base : bases)
+		if (DB::Record::Lookup(base.first, type))
+			matching.insert(base.second.begin(), base.second.end());
+
+	if (matching.empty())
+		return result;
+
+	// callers expect the items in container order
+	result.reserve(matching.size());
+	copy_if(container.begin(), container.end(), back_inserter(result), [&matching](NetworkID id) { return matching.count(id); });
 
 	return result;
 }
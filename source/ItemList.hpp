@@ -13,6 +13,7 @@
 
 #include <vector>
 #include <tuple>
+#include <unordered_map>
 
 class ItemList : public virtual Base
 {
@@ -28,15 +29,19 @@ class ItemList : public virtual Base
 #endif
 
 		RakNet::NetworkID FindStackableItem(unsigned int baseID, float condition) const;
+		void Insert(RakNet::NetworkID id, unsigned int baseID);
+		void Erase(RakNet::NetworkID id, unsigned int baseID);
 
 		Impl container;
+		// the items of each baseID in container order, so lookups by baseID only lock matching items
+		std::unordered_map<unsigned int, Impl> bases;
 
 		void initialize();
 
 		ItemList(const ItemList&) = delete;
 		ItemList& operator=(const ItemList&) = delete;
 
-		virtual void freecontents() { container.clear(); }
+		virtual void freecontents() { container.clear(); bases.clear(); }
 
 	protected:
 		ItemList();
@@ -46,11 +51,22 @@ class ItemList : public virtual Base
 	public:
 		typedef std::pair<bool, RakNet::NetworkID> AddOp;
 		typedef std::tuple<unsigned int, Impl, RakNet::NetworkID> RemoveOp;
+		// baseID, count, condition
+		typedef std::tuple<unsigned int, unsigned int, float> Entry;
+		typedef std::vector<Entry> Entries;
+		// created items, and existing stacks with their new count
+		typedef std::pair<Impl, std::vector<std::pair<RakNet::NetworkID, unsigned int>>> AddItemsOp;
 
 		virtual ~ItemList() noexcept;
 
 		RakNet::NetworkID AddItem(RakNet::NetworkID id);
 		AddOp AddItem(unsigned int baseID, unsigned int count, float condition, bool silent);
+		/**
+		 * \brief Adds many items at once, e.g. the contents of a base container
+		 *
+		 * Entries of the same item are merged and the current contents are only scanned once
+		 */
+		AddItemsOp AddItems(const Entries& entries, bool silent);
 		void RemoveItem(RakNet::NetworkID id);
 		RemoveOp RemoveItem(unsigned int baseID, unsigned int count, bool silent);
 		RakNet::NetworkID EquipItem(unsigned int baseID, bool silent, bool stick) const;
@@ -62,7 +78,7 @@ class ItemList : public virtual Base
 		const Impl& GetItemList() const { return container; }
 
 #ifdef VAULTSERVER
-		Impl GetItemTypes(const std::string& type) const;
+		Impl GetItemTypes(const char* type) const;
 #endif
 
 		/**
@@ -2,6 +2,8 @@
 
 #ifndef VAULTSERVER
 #include "Game.hpp"
+#else
+#include "vaultserver/Grid.hpp"
 #endif
 
 using namespace std;
@@ -47,7 +49,9 @@ Object::Object(const pPacket& packet) : Reference(PacketFactory::Pop<pPacket>(pa
 
 Object::~Object() noexcept
 {
-
+#ifdef VAULTSERVER
+	Grid::Remove(this->GetNetworkID());
+#endif
 }
 
 void Object::initialize()
@@ -135,7 +139,14 @@ Lockable* Object::SetNetworkPos(const tuple<float, float, float>& pos)
 	if (!IsValidCoordinate(get<0>(pos)) || !IsValidCoordinate(get<1>(pos)) || !IsValidCoordinate(get<2>(pos)))
 		return nullptr;
 
-	return SetObjectValue(this->object_Network_Pos, pos);
+	Lockable* result = SetObjectValue(this->object_Network_Pos, pos);
+
+#ifdef VAULTSERVER
+	if (result)
+		Grid::Update(this->GetNetworkID(), this->GetNetworkCell(), pos);
+#endif
+
+	return result;
 }
 
 Lockable* Object::SetAngle(const tuple<float, float, float>& angle)
@@ -159,7 +170,14 @@ Lockable* Object::SetNetworkCell(unsigned int cell)
 	if (!cell)
 		return nullptr;
 
-	return SetObjectValue(this->cell_Network, cell);
+	Lockable* result = SetObjectValue(this->cell_Network, cell);
+
+#ifdef VAULTSERVER
+	if (result)
+		Grid::Update(this->GetNetworkID(), cell, this->GetNetworkPos());
+#endif
+
+	return result;
 }
 
 Lockable* Object::SetEnabled(bool state)
@@ -209,7 +227,8 @@ bool Object::HasValidCoordinates() const
 #ifdef VAULTSERVER
 Lockable* Object::SetBase(unsigned int baseID)
 {
-	const DB::Record* record = *DB::Record::Lookup(baseID, vector<string>{"DOOR", "TERM", "STAT"});
+	constexpr unsigned int types = DB::Record::Mask("DOOR", "TERM", "STAT");
+	const DB::Record* record = *DB::Record::Lookup(baseID, types);
 
 	if (this->GetName().empty())
 		this->SetName(record->GetDescription());
@@ -4,6 +4,8 @@
 
 #ifndef VAULTSERVER
 #include "Game.hpp"
+#else
+#include "vaultserver/NPC.hpp"
 #endif
 
 using namespace std;
@@ -11,7 +13,6 @@ using namespace RakNet;
 using namespace Values;
 
 #ifdef VAULTSERVER
-Guarded<Player::BaseIDTracker> Player::baseIDs;
 Guarded<Player::WindowTracker> Player::attachedWindows;
 
 atomic<unsigned int> Player::default_respawn(DEFAULT_PLAYER_RESPAWN);
@@ -53,9 +54,7 @@ Player::~Player() noexcept
 #endif
 
 #ifdef VAULTSERVER
-	baseIDs.Operate([this](BaseIDTracker& baseIDs) {
-		baseIDs.erase(find(baseIDs.begin(), baseIDs.end(), this->GetBase()));
-	});
+	DB::NPC::Release(this->GetBase());
 
 	attachedWindows.Operate([this](WindowTracker& attachedWindows) {
 		for (auto id : *player_Windows)
@@ -70,9 +69,8 @@ void Player::initialize()
 		player_Controls.emplace(control, make_pair(Value<unsigned char>(), Value<bool>(true)));
 
 #ifdef VAULTSERVER
-	baseIDs.Operate([this](BaseIDTracker& baseIDs) {
-		baseIDs.emplace_back(this->GetBase());
-	});
+	// players get NPC bases nobody else uses, see DB::NPC::GetNPC
+	DB::NPC::Claim(this->GetBase());
 
 	player_Respawn.set(default_respawn);
 	player_Cell.set(default_cell);
@@ -242,9 +240,10 @@ Lockable* Player::SetBase(unsigned int baseID)
 	auto ret = Actor::SetBase(baseID);
 
 	if (ret)
-		baseIDs.Operate([prev_baseID, baseID](BaseIDTracker& baseIDs) {
-			*find(baseIDs.begin(), baseIDs.end(), prev_baseID) = baseID;
-		});
+	{
+		DB::NPC::Release(prev_baseID);
+		DB::NPC::Claim(baseID);
+	}
 
 	return ret;
 }
@@ -26,7 +26,6 @@ class Player : public Actor
 	public:
 		typedef std::array<unsigned int, 9> CellContext;
 		typedef std::vector<RakNet::NetworkID> AttachedWindows;
-		typedef std::vector<unsigned int> BaseIDTracker;
 		typedef std::unordered_map<RakNet::NetworkID, std::vector<RakNet::NetworkID>> WindowTracker;
 
 	private:
@@ -35,7 +34,6 @@ class Player : public Actor
 #endif
 
 #ifdef VAULTSERVER
-		static Guarded<BaseIDTracker> baseIDs;
 		static Guarded<WindowTracker> attachedWindows;
 
 		static std::atomic<unsigned int> default_respawn;
@@ -91,10 +89,6 @@ class Player : public Actor
 		 * \brief Sets the default console state
 		 */
 		static void SetConsoleEnabled(bool enabled);
-		/**
-		 * \brief Returns the set of all used base IDs by players
-		 */
-		static BaseIDTracker GetBaseIDs() { return baseIDs.Operate([](BaseIDTracker& baseIDs) { return baseIDs; }); }
 		/**
 		 * \brief Returns the set of players who have a given window attached
 		 */
@@ -1,7 +1,51 @@
 #include "ServerEntry.hpp"
 
+#include <algorithm>
+
 using namespace std;
 
+// entries in static objects of other translation units may release strings during static destruction, so the pool is never destroyed
+ServerEntry::Pool& ServerEntry::pool = *new ServerEntry::Pool;
+
+ServerEntry::Interned ServerEntry::Intern(const string& str)
+{
+	lock_guard<mutex> lock(pool.cs);
+
+	auto& slot = pool.strings[str];
+	Interned interned = slot.lock();
+
+	if (!interned)
+	{
+		interned = Interned(new string(str), Release);
+		slot = interned;
+	}
+
+	return interned;
+}
+
+ServerEntry::Interned ServerEntry::Find(const string& str)
+{
+	lock_guard<mutex> lock(pool.cs);
+
+	auto it = pool.strings.find(str);
+	return it != pool.strings.end() ? it->second.lock() : nullptr;
+}
+
+void ServerEntry::Release(const string* str)
+{
+	{
+		lock_guard<mutex> lock(pool.cs);
+
+		// the string may have been interned again meanwhile, the slot then refers to the new copy
+		auto it = pool.strings.find(*str);
+
+		if (it != pool.strings.end() && it->second.expired())
+			pool.strings.erase(it);
+	}
+
+	delete str;
+}
+
 void ServerEntry::SetServerName(const string& name)
 {
 	this->name = name;
@@ -14,8 +58,13 @@ void ServerEntry::SetServerMap(const string& map)
 
 void ServerEntry::SetServerRule(const string& rule, const string& value)
 {
-	this->rules.erase(rule);
-	this->rules.emplace(rule, value);
+	Interned key = Intern(rule);
+	auto it = lower_bound(rules.begin(), rules.end(), rule, [](const Rule& a, const string& b) { return *a.key < b; });
+
+	if (it != rules.end() && it->key == key)
+		it->value = Intern(value);
+	else
+		rules.insert(it, Rule{key, Intern(value)});
 }
 
 void ServerEntry::SetServerPlayers(const pair<unsigned int, unsigned int>& players)
@@ -30,35 +79,35 @@ void ServerEntry::SetServerPing(unsigned int ping)
 
 void ServerEntry::SetModFiles(const string& name)
 {
-	this->modfiles.push_back(name);
+	this->modfiles.push_back(Intern(name));
 }
 
-const string& ServerEntry::GetServerName()
+const string& ServerEntry::GetServerName() const
 {
 	return name;
 }
 
-const string& ServerEntry::GetServerMap()
+const string& ServerEntry::GetServerMap() const
 {
 	return map;
 }
 
-const map<string, string>& ServerEntry::GetServerRules()
+const ServerEntry::Rules& ServerEntry::GetServerRules() const
 {
 	return rules;
 }
 
-const pair<unsigned int, unsigned int>& ServerEntry::GetServerPlayers()
+const pair<unsigned int, unsigned int>& ServerEntry::GetServerPlayers() const
 {
 	return players;
 }
 
-unsigned int ServerEntry::GetServerPing()
+unsigned int ServerEntry::GetServerPing() const
 {
 	return ping;
 }
 
-const std::vector<string>& ServerEntry::GetServerModFiles()
+const ServerEntry::ModFiles& ServerEntry::GetServerModFiles() const
 {
 	return modfiles;
 }
@@ -6,21 +6,60 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
 #include <climits>
 
 class ServerEntry
 {
+	public:
+		typedef std::shared_ptr<const std::string> Interned;
+
+		/**
+		 * \brief A rule of a server, key and value are interned
+		 */
+		struct Rule
+		{
+			Interned key;
+			Interned value;
+		};
+
+		typedef std::vector<Rule> Rules;
+		typedef std::vector<Interned> ModFiles;
+
 	private:
+		// rule keys, values and mod file names are shared by all entries and compared by address.
+		// a string is freed with its last reference, so strings of expired servers don't accumulate
+		struct Pool
+		{
+			std::mutex cs;
+			std::unordered_map<std::string, std::weak_ptr<const std::string>> strings;
+		};
+
+		static Pool& pool;
+
+		static void Release(const std::string* str);
+
 		std::string name;
 		std::string map;
-		std::map<std::string, std::string> rules;
+		Rules rules;
 		std::pair<unsigned int, unsigned int> players;
 		unsigned int ping;
-		std::vector<std::string> modfiles;
+		ModFiles modfiles;
 
 		ServerEntry& operator=(const ServerEntry&) = delete;
 
 	public:
+		/**
+		 * \brief Returns the interned copy of a string, creating it if necessary
+		 */
+		static Interned Intern(const std::string& str);
+		/**
+		 * \brief Returns the interned copy of a string, or nullptr if no entry holds it
+		 */
+		static Interned Find(const std::string& str);
+
 		void SetServerName(const std::string& name);
 		void SetServerMap(const std::string& map);
 		void SetServerRule(const std::string& rule, const std::string& value);
@@ -28,16 +67,69 @@ class ServerEntry
 		void SetServerPing(unsigned int ping);
 		void SetModFiles(const std::string& name);
 
-		const std::string& GetServerName();
-		const std::string& GetServerMap();
-		const std::map<std::string, std::string>& GetServerRules();
-		const std::pair<unsigned int, unsigned int>& GetServerPlayers();
-		unsigned int GetServerPing();
-		const std::vector<std::string>& GetServerModFiles();
+		const std::string& GetServerName() const;
+		const std::string& GetServerMap() const;
+		/**
+		 * \brief Returns the rules sorted by key
+		 */
+		const Rules& GetServerRules() const;
+		const std::pair<unsigned int, unsigned int>& GetServerPlayers() const;
+		unsigned int GetServerPing() const;
+		const ModFiles& GetServerModFiles() const;
 		void ClearModFiles();
 
 		ServerEntry() : name("Vault-Tec Multiplayer Mod server"), map("default"), ping(USHRT_MAX) {}
 		ServerEntry(const std::string& name, const std::string& map, const std::pair<unsigned int, unsigned int>& players, unsigned int ping) : name(name), map(map), players(players), ping(ping) {}
 };
 
+/**
+ * \brief A filtered ID_MASTER_QUERY, built by clients and answered by the master server
+ *
+ * An ID_MASTER_QUERY without payload is answered with every server. A client may append:
+ *
+ * unsigned int generation: 0, or the generation of a previous reply to only get servers changed since
+ * unsigned int cursor, limit: rows to skip and to return (0 returns all)
+ * unsigned char sort: a QuerySort
+ * unsigned char flags: QueryFlags
+ * RakString name, map: name substring and exact map, empty matches any
+ * unsigned int count, RakString[count]: mod files a server must have
+ * unsigned int count, (RakString key, RakString value)[count]: rules a server must have
+ *
+ * The reply is the usual server list for the page, followed by the number of matches before paging,
+ * the current generation, a bool set if the requested generation was too old for a delta and the full
+ * result was sent, and the addresses of servers removed since the requested generation. For a delta, servers
+ * which changed since and no longer match the filter are among the removed addresses.
+ *
+ * With the Dictionary flag, the count of servers is followed by unsigned short count, RakString[count] holding every
+ * rule key, rule value and mod file of the page once. Each server then writes unsigned short counts and unsigned short
+ * indexes into this dictionary instead of its rule and mod file strings. A page ends early if the dictionary is full.
+ */
+struct ServerQuery
+{
+	enum QuerySort : unsigned char
+	{
+		SortNone,
+		SortName,
+		SortMap,
+		SortPlayers,
+	};
+
+	enum QueryFlags : unsigned char
+	{
+		NotFull    = 0x01,
+		NotEmpty   = 0x02,
+		Dictionary = 0x04,
+	};
+
+	unsigned int generation = 0;
+	unsigned int cursor = 0;
+	unsigned int limit = 0;
+	unsigned char sort = SortNone;
+	unsigned char flags = 0;
+	std::string name;
+	std::string map;
+	std::vector<std::string> modfiles;
+	std::vector<std::pair<std::string, std::string>> rules;
+};
+
 #endif
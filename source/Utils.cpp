@@ -92,7 +92,7 @@ string Utils::str_replace(const string& source, const char* find, const char* re
 {
 	unsigned int find_len = strlen(find);
 	unsigned int replace_len = strlen(replace);
-	unsigned int pos = 0;
+	size_t pos = 0;
 
 	string dest = source;
 
@@ -41,6 +41,7 @@
   #if defined AMX_JIT
     #include <sys/types.h>
     #include <sys/mman.h>
+    #include <unistd.h>     /* for sysconf() */
   #endif
 #endif
 #if defined __LCC__ || defined __LINUX__
@@ -1390,6 +1391,7 @@ int AMXAPI amx_InitJIT(AMX *amx, void *reloc_table, void *native_code)
 
   if ((amx->flags & AMX_FLAG_JITC)==0)
     return AMX_ERR_INIT_JIT;    /* flag not set, this AMX is not prepared for JIT */
+  hdr=(AMX_HEADER *)amx->base;
   if (hdr->file_version>MAX_FILE_VER_JIT)
     return AMX_ERR_VERSION;     /* JIT may not support the newest file version(s) */
   /* the JIT does not support overlays, but this is already checked in VerifyPcode()
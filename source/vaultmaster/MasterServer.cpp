@@ -6,8 +6,20 @@ using namespace std;
 RakPeerInterface* MasterServer::peer;
 SocketDescriptor* MasterServer::sockdescr;
 
-typedef map<SystemAddress, ServerEntry> ServerMap;
-ServerMap MasterServer::serverList;
+ServerRegistry MasterServer::registry;
+bool MasterServer::registryChanged = false;
+Time MasterServer::registryPublished = 0;
+constexpr unsigned int MasterServer::MAX_REMOVED;
+map<SystemAddress, Time> MasterServer::serverSeen;
+set<pair<Time, SystemAddress>> MasterServer::serverExpiry;
+Time MasterServer::serverTTL;
+unsigned int MasterServer::connections;
+shared_ptr<const ServerRegistry> MasterServer::published;
+mutex MasterServer::queueLock;
+condition_variable MasterServer::queueSignal;
+deque<Packet*> MasterServer::queries;
+bool MasterServer::queueOpen = false;
+vector<std::thread> MasterServer::workers;
 
 bool MasterServer::thread;
 
@@ -18,26 +30,494 @@ void MasterServer::TerminateThread()
 
 void MasterServer::RemoveServer(SystemAddress addr)
 {
-	map<SystemAddress, ServerEntry>::iterator i;
-	i = serverList.find(addr);
+	auto i = registry.servers.find(addr);
 
-	if (i != serverList.end())
-		serverList.erase(i);
+	if (i != registry.servers.end())
+	{
+		IndexServer(addr, i->second->entry, false);
+		registry.changed.erase(i->second->generation);
+		registry.servers.erase(i);
+		serverExpiry.erase(make_pair(serverSeen[addr], addr));
+		registryChanged = true;
+
+		registry.removed[addr] = ++registry.generation;
+		registry.removedOrder.emplace(registry.generation, addr);
+
+		if (registry.removed.size() > MAX_REMOVED)
+		{
+			auto oldest = registry.removedOrder.begin();
+			registry.removedPruned = oldest->first;
+			registry.removed.erase(oldest->second);
+			registry.removedOrder.erase(oldest);
+		}
+	}
+}
+
+void MasterServer::ExpireServers(Time now)
+{
+	while (!serverExpiry.empty() && (now - serverExpiry.begin()->first) >= serverTTL)
+	{
+		SystemAddress addr = serverExpiry.begin()->second;
+
+		Utils::timestamp();
+		printf("Server expired (%s)\n", addr.ToString());
+		RemoveServer(addr);
+	}
+}
+
+void MasterServer::IndexServer(SystemAddress addr, const ServerEntry& entry, bool index)
+{
+	// returns true if the set became empty. empty sets are erased, an interned string may be freed with the last server using it
+	auto update = [addr, index](ServerSet& servers) {
+		if (index)
+			servers.insert(addr);
+		else
+			servers.erase(addr);
+
+		return servers.empty();
+	};
+
+	if (update(registry.mapIndex[entry.GetServerMap()]))
+		registry.mapIndex.erase(entry.GetServerMap());
+
+	for (const auto& mod : entry.GetServerModFiles())
+		if (update(registry.modIndex[mod.get()]))
+			registry.modIndex.erase(mod.get());
+
+	for (const auto& rule : entry.GetServerRules())
+	{
+		auto key = make_pair(rule.key.get(), rule.value.get());
+
+		if (update(registry.ruleIndex[key]))
+			registry.ruleIndex.erase(key);
+	}
+}
+
+void MasterServer::CacheServer(SystemAddress addr, const ServerEntry& entry)
+{
+	BitStream query;
+	RakString name(entry.GetServerName().c_str());
+	RakString map(entry.GetServerMap().c_str());
+	unsigned int players = entry.GetServerPlayers().first;
+	unsigned int playersMax = entry.GetServerPlayers().second;
+	const ServerEntry::Rules& rules = entry.GetServerRules();
+	const ServerEntry::ModFiles& modfiles = entry.GetServerModFiles();
+
+	query.Write(name);
+	query.Write(map);
+	query.Write(players);
+	query.Write(playersMax);
+
+	unsigned int head = query.GetNumberOfBytesUsed();
+
+	query.Write(static_cast<unsigned int>(rules.size()));
+
+	for (const auto& k : rules)
+	{
+		RakString key(k.key->c_str());
+		RakString value(k.value->c_str());
+		query.Write(key);
+		query.Write(value);
+	}
+
+	query.Write(static_cast<unsigned int>(modfiles.size()));
+
+	for (const auto& k : modfiles)
+	{
+		RakString mod_name(k->c_str());
+		query.Write(mod_name);
+	}
+
+	// entries may still be read by workers through an older snapshot, so they are replaced rather than modified
+	auto i = registry.servers.find(addr);
+
+	if (i != registry.servers.end())
+	{
+		IndexServer(addr, i->second->entry, false);
+		registry.changed.erase(i->second->generation);
+	}
+
+	// nothing above writes single bits, so the entry is a whole number of bytes
+	registry.servers[addr] = make_shared<const ServerCached>(ServerCached{entry, string(reinterpret_cast<const char*>(query.GetData()), query.GetNumberOfBytesUsed()), head, ++registry.generation});
+	registry.changed.emplace(registry.generation, addr);
+
+	auto tombstone = registry.removed.find(addr);
+
+	if (tombstone != registry.removed.end())
+	{
+		registry.removedOrder.erase(tombstone->second);
+		registry.removed.erase(tombstone);
+	}
+
+	registryChanged = true;
+
+	IndexServer(addr, entry, true);
+}
+
+void MasterServer::PublishRegistry()
+{
+	auto snapshot = make_shared<ServerRegistry>(registry);
+
+	BitStream query;
+	query.Write((MessageID) ID_MASTER_QUERY);
+	query.Write((unsigned int) snapshot->servers.size());
+
+	for (const auto& server : snapshot->servers)
+	{
+		query.Write(server.first);
+		query.Write(server.second->data.data(), server.second->data.size());
+	}
+
+	snapshot->query.assign(reinterpret_cast<const char*>(query.GetData()), query.GetNumberOfBytesUsed());
+
+	atomic_store(&published, shared_ptr<const ServerRegistry>(move(snapshot)));
+
+	registryChanged = false;
+	registryPublished = GetTime();
+}
+
+void MasterServer::FilterServerQuery(BitStream& query, const ServerRegistry& snapshot, const ServerQuery& filter)
+{
+	// a delta older than the oldest removal still known can't be answered, send the full result instead
+	bool reset = filter.generation && filter.generation < snapshot.removedPruned;
+	unsigned int since = reset ? 0 : filter.generation;
+
+	// start from the smallest index set that applies, the remaining filters are tested per server
+	static const ServerSet none;
+	const ServerSet* candidates = nullptr;
+
+	auto narrow = [&candidates](const ServerSet* servers) {
+		if (!candidates || servers->size() < candidates->size())
+			candidates = servers;
+	};
+
+	if (!filter.map.empty())
+	{
+		auto it = snapshot.mapIndex.find(filter.map);
+		narrow(it != snapshot.mapIndex.end() ? &it->second : &none);
+	}
+
+	// strings that were never interned can't be used by any server
+	vector<ServerEntry::Interned> modfiles;
+	vector<ServerEntry::Rule> rules;
+
+	for (const auto& mod : filter.modfiles)
+	{
+		ServerEntry::Interned mod_name = ServerEntry::Find(mod);
+		auto it = snapshot.modIndex.find(mod_name.get());
+		narrow(it != snapshot.modIndex.end() ? &it->second : &none);
+		modfiles.emplace_back(mod_name);
+	}
+
+	for (const auto& rule : filter.rules)
+	{
+		ServerEntry::Rule interned{ServerEntry::Find(rule.first), ServerEntry::Find(rule.second)};
+		auto it = snapshot.ruleIndex.find(make_pair(interned.key.get(), interned.value.get()));
+		narrow(it != snapshot.ruleIndex.end() ? &it->second : &none);
+		rules.emplace_back(interned);
+	}
+
+	vector<ServerCache::const_iterator> result;
+	vector<SystemAddress> removed;
+
+	auto test = [&filter, &modfiles, &rules, since](ServerCache::const_iterator i) {
+		const ServerEntry& entry = i->second->entry;
+		const auto& players = entry.GetServerPlayers();
+
+		if (since && i->second->generation <= since)
+			return false;
+
+		if (!filter.name.empty() && entry.GetServerName().find(filter.name) == string::npos)
+			return false;
+
+		if (!filter.map.empty() && entry.GetServerMap() != filter.map)
+			return false;
+
+		if (((filter.flags & ServerQuery::NotFull) && players.first >= players.second) || ((filter.flags & ServerQuery::NotEmpty) && !players.first))
+			return false;
+
+		const auto& server_modfiles = entry.GetServerModFiles();
+
+		for (const auto& mod : modfiles)
+			if (find(server_modfiles.begin(), server_modfiles.end(), mod) == server_modfiles.end())
+				return false;
+
+		const auto& server_rules = entry.GetServerRules();
+
+		for (const auto& rule : rules)
+			if (find_if(server_rules.begin(), server_rules.end(), [&rule](const ServerEntry::Rule& k) { return k.key == rule.key && k.value == rule.value; }) == server_rules.end())
+				return false;
+
+		return true;
+	};
+
+	if (since)
+	{
+		// a delta only looks at servers changed since. one that no longer matches may have matched before, so it is reported as removed
+		for (auto c = snapshot.changed.upper_bound(since); c != snapshot.changed.end(); ++c)
+		{
+			auto i = snapshot.servers.find(c->second);
+
+			if (test(i))
+				result.emplace_back(i);
+			else
+				removed.emplace_back(c->second);
+		}
+	}
+	else if (candidates)
+	{
+		for (const auto& addr : *candidates)
+		{
+			auto i = snapshot.servers.find(addr);
+
+			if (i != snapshot.servers.end() && test(i))
+				result.emplace_back(i);
+		}
+	}
+	else
+		for (auto i = snapshot.servers.begin(); i != snapshot.servers.end(); ++i)
+			if (test(i))
+				result.emplace_back(i);
+
+	switch (filter.sort)
+	{
+		case ServerQuery::SortName:
+			stable_sort(result.begin(), result.end(), [](ServerCache::const_iterator a, ServerCache::const_iterator b) { return a->second->entry.GetServerName() < b->second->entry.GetServerName(); });
+			break;
+
+		case ServerQuery::SortMap:
+			stable_sort(result.begin(), result.end(), [](ServerCache::const_iterator a, ServerCache::const_iterator b) { return a->second->entry.GetServerMap() < b->second->entry.GetServerMap(); });
+			break;
+
+		case ServerQuery::SortPlayers:
+			stable_sort(result.begin(), result.end(), [](ServerCache::const_iterator a, ServerCache::const_iterator b) { return a->second->entry.GetServerPlayers().first > b->second->entry.GetServerPlayers().first; });
+			break;
+
+		default:
+			break;
+	}
+
+	unsigned int first = min(filter.cursor, static_cast<unsigned int>(result.size()));
+	unsigned int available = result.size() - first;
+	// added to first after clamping, a limit near UINT_MAX would wrap around otherwise
+	unsigned int last = first + (filter.limit ? min(filter.limit, available) : available);
+
+	query.Write((MessageID) ID_MASTER_QUERY);
+
+	if (filter.flags & ServerQuery::Dictionary)
+	{
+		// every rule and mod file string of the page is written once, servers refer to it by index
+		std::map<const string*, unsigned short> dictionary;
+		vector<const string*> strings;
+
+		auto reference = [&dictionary, &strings](const string* str) {
+			if (dictionary.emplace(str, strings.size()).second)
+				strings.emplace_back(str);
+		};
+
+		for (unsigned int i = first; i < last; ++i)
+		{
+			const ServerEntry& entry = result[i]->second->entry;
+
+			if (strings.size() + entry.GetServerRules().size() * 2 + entry.GetServerModFiles().size() > USHRT_MAX)
+			{
+				last = i;
+				break;
+			}
+
+			for (const auto& rule : entry.GetServerRules())
+			{
+				reference(rule.key.get());
+				reference(rule.value.get());
+			}
+
+			for (const auto& mod : entry.GetServerModFiles())
+				reference(mod.get());
+		}
+
+		query.Write(last - first);
+		query.Write(static_cast<unsigned short>(strings.size()));
+
+		for (const auto& str : strings)
+		{
+			RakString value(str->c_str());
+			query.Write(value);
+		}
+
+		for (unsigned int i = first; i < last; ++i)
+		{
+			const ServerCached& cached = *result[i]->second;
+			const auto& server_rules = cached.entry.GetServerRules();
+			const auto& server_modfiles = cached.entry.GetServerModFiles();
+
+			query.Write(result[i]->first);
+			query.Write(cached.data.data(), cached.head);
+			query.Write(static_cast<unsigned short>(server_rules.size()));
+
+			for (const auto& rule : server_rules)
+			{
+				query.Write(dictionary[rule.key.get()]);
+				query.Write(dictionary[rule.value.get()]);
+			}
+
+			query.Write(static_cast<unsigned short>(server_modfiles.size()));
+
+			for (const auto& mod : server_modfiles)
+				query.Write(dictionary[mod.get()]);
+		}
+	}
+	else
+	{
+		query.Write(last - first);
+
+		for (unsigned int i = first; i < last; ++i)
+		{
+			query.Write(result[i]->first);
+			query.Write(result[i]->second->data.data(), result[i]->second->data.size());
+		}
+	}
+
+	query.Write(static_cast<unsigned int>(result.size()));
+	query.Write(snapshot.generation);
+	query.Write(reset);
+
+	if (since)
+		for (auto r = snapshot.removedOrder.upper_bound(since); r != snapshot.removedOrder.end(); ++r)
+			removed.emplace_back(r->second);
+
+	query.Write(static_cast<unsigned int>(removed.size()));
+
+	for (const auto& addr : removed)
+		query.Write(addr);
+}
+
+void MasterServer::ProcessQuery(Packet* packet, const ServerRegistry& snapshot)
+{
+	switch (packet->data[0])
+	{
+		case ID_MASTER_QUERY:
+		{
+			if (packet->length > sizeof(MessageID))
+			{
+				BitStream query(packet->data, packet->length, false);
+				query.IgnoreBytes(sizeof(MessageID));
+
+				ServerQuery filter;
+				RakString name, map;
+				unsigned int msize = 0, rsize = 0;
+
+				bool valid = query.Read(filter.generation) && query.Read(filter.cursor) && query.Read(filter.limit) && query.Read(filter.sort) && query.Read(filter.flags) && query.Read(name) && query.Read(map);
+				filter.name = name.C_String();
+				filter.map = map.C_String();
+
+				valid = valid && query.Read(msize);
+
+				for (unsigned int j = 0; valid && j < msize; j++)
+				{
+					RakString mod_name;
+					valid = query.Read(mod_name);
+					filter.modfiles.emplace_back(mod_name.C_String());
+				}
+
+				valid = valid && query.Read(rsize);
+
+				for (unsigned int j = 0; valid && j < rsize; j++)
+				{
+					RakString key, value;
+					valid = query.Read(key) && query.Read(value);
+					filter.rules.emplace_back(key.C_String(), value.C_String());
+				}
+
+				// a short payload would filter and page by whatever the reads left behind
+				if (!valid)
+				{
+					Utils::timestamp();
+					printf("Query dropped, malformed (%s)\n", packet->systemAddress.ToString());
+					break;
+				}
+
+				BitStream response;
+				FilterServerQuery(response, snapshot, filter);
+				peer->Send(&response, HIGH_PRIORITY, RELIABLE, 0, packet->systemAddress, false, 0);
+			}
+			else
+				peer->Send(snapshot.query.data(), snapshot.query.size(), HIGH_PRIORITY, RELIABLE, 0, packet->systemAddress, false, 0);
+
+			Utils::timestamp();
+			printf("Query processed (%s)\n", packet->systemAddress.ToString());
+			break;
+		}
+
+		case ID_MASTER_UPDATE:
+		{
+			BitStream queryy(packet->data, packet->length, false);
+			queryy.IgnoreBytes(sizeof(MessageID));
+
+			SystemAddress addr;
+			queryy.Read(addr);
+
+			BitStream query;
+
+			auto i = snapshot.servers.find(addr);
+
+			query.Write((MessageID) ID_MASTER_UPDATE);
+			query.Write(addr);
+
+			if (i != snapshot.servers.end())
+				query.Write(i->second->data.data(), i->second->data.size());
+
+			peer->Send(&query, HIGH_PRIORITY, RELIABLE, 0, packet->systemAddress, false, 0);
+
+			Utils::timestamp();
+			printf("Update processed (%s)\n", packet->systemAddress.ToString());
+			break;
+		}
+	}
+}
+
+void MasterServer::WorkerThread()
+{
+	while (true)
+	{
+		Packet* packet;
+
+		{
+			unique_lock<mutex> lock(queueLock);
+			queueSignal.wait(lock, []() { return !queries.empty() || !queueOpen; });
+
+			if (queries.empty())
+				return;
+
+			packet = queries.front();
+			queries.pop_front();
+		}
+
+		shared_ptr<const ServerRegistry> snapshot = atomic_load(&published);
+		ProcessQuery(packet, *snapshot);
+		peer->DeallocatePacket(packet);
+	}
 }
 
 void MasterServer::MasterThread()
 {
 	sockdescr = new SocketDescriptor(RAKNET_PORT, 0);
 	peer = RakPeerInterface::GetInstance();
-	peer->Startup(RAKNET_CONNECTIONS, sockdescr, 1, THREAD_PRIORITY_NORMAL);
-	peer->SetMaximumIncomingConnections(RAKNET_CONNECTIONS);
+	peer->Startup(connections, sockdescr, 1, THREAD_PRIORITY_NORMAL);
+	peer->SetMaximumIncomingConnections(connections);
 	peer->SetIncomingPassword(MASTER_VERSION, sizeof(MASTER_VERSION));
 
+	PublishRegistry();
+
+	queueOpen = true;
+
+	for (unsigned int i = max(std::thread::hardware_concurrency(), 1u); i; --i)
+		workers.emplace_back(WorkerThread);
+
 	Packet* packet;
 
 	while (thread)
 	{
-		for (packet = peer->Receive(); packet; peer->DeallocatePacket(packet), packet = peer->Receive())
+		while ((packet = peer->Receive()))
 		{
 			switch (packet->data[0])
 			{
@@ -50,116 +530,27 @@ void MasterServer::MasterThread()
 					Utils::timestamp();
 					printf("Client disconnected (%s)\n", packet->systemAddress.ToString());
 					RemoveServer(packet->systemAddress);
+					serverSeen.erase(packet->systemAddress);
 					break;
 
 				case ID_CONNECTION_LOST:
 					Utils::timestamp();
 					printf("Lost connection (%s)\n", packet->systemAddress.ToString());
 					RemoveServer(packet->systemAddress);
+					serverSeen.erase(packet->systemAddress);
 					break;
 
 				case ID_MASTER_QUERY:
-				{
-					BitStream query;
-					query.Write((MessageID) ID_MASTER_QUERY);
-					query.Write((unsigned int) serverList.size());
-
-					for (map<SystemAddress, ServerEntry>::iterator i = serverList.begin(); i != serverList.end(); ++i)
-					{
-						SystemAddress addr = i->first;
-						ServerEntry entry = i->second;
-						RakString name(entry.GetServerName().c_str());
-						RakString map(entry.GetServerMap().c_str());
-						unsigned int players = entry.GetServerPlayers().first;
-						unsigned int playersMax = entry.GetServerPlayers().second;
-						const std::map<string, string>& rules = entry.GetServerRules();
-						const std::vector<string>& modfiles = entry.GetServerModFiles();
-
-						query.Write(addr);
-						query.Write(name);
-						query.Write(map);
-						query.Write(players);
-						query.Write(playersMax);
-						query.Write(rules.size());
-
-						for (const auto& k : rules)
-						{
-							RakString key(k.first.c_str());
-							RakString value(k.second.c_str());
-							query.Write(key);
-							query.Write(value);
-						}
-
-						query.Write(modfiles.size());
-
-						for (const auto& k : modfiles)
-						{
-						    RakString mod_name(k.c_str());
-						    query.Write(mod_name);
-						}
-					}
-
-					peer->Send(&query, HIGH_PRIORITY, RELIABLE, 0, packet->systemAddress, false, 0);
-
-					Utils::timestamp();
-					printf("Query processed (%s)\n", packet->systemAddress.ToString());
-					break;
-				}
-
 				case ID_MASTER_UPDATE:
 				{
-					BitStream queryy(packet->data, packet->length, false);
-					queryy.IgnoreBytes(sizeof(MessageID));
-
-					SystemAddress addr;
-					queryy.Read(addr);
-
-					BitStream query;
-
-					map<SystemAddress, ServerEntry>::iterator i;
-					i = serverList.find(addr);
-
-					query.Write((MessageID) ID_MASTER_UPDATE);
-					query.Write(addr);
-
-					if (i != serverList.end())
+					// answered by a worker from the published registry, the worker deallocates the packet
 					{
-						ServerEntry entry = i->second;
-						RakString name(entry.GetServerName().c_str());
-						RakString map(entry.GetServerMap().c_str());
-						unsigned int players = entry.GetServerPlayers().first;
-						unsigned int playersMax = entry.GetServerPlayers().second;
-						const std::map<string, string>& rules = entry.GetServerRules();
-						const std::vector<string>& modfiles = entry.GetServerModFiles();
-
-						query.Write(name);
-						query.Write(map);
-						query.Write(players);
-						query.Write(playersMax);
-						query.Write(rules.size());
-
-						for (const auto& k : rules)
-						{
-							RakString key(k.first.c_str());
-							RakString value(k.second.c_str());
-							query.Write(key);
-							query.Write(value);
-						}
-
-						query.Write(modfiles.size());
-
-						for (const auto& k : modfiles)
-						{
-						    RakString mod_name(k.c_str());
-						    query.Write(mod_name);
-						}
+						lock_guard<mutex> lock(queueLock);
+						queries.emplace_back(packet);
 					}
 
-					peer->Send(&query, HIGH_PRIORITY, RELIABLE, 0, packet->systemAddress, false, 0);
-
-					Utils::timestamp();
-					printf("Update processed (%s)\n", packet->systemAddress.ToString());
-					break;
+					queueSignal.notify_one();
+					continue;
 				}
 
 				case ID_MASTER_ANNOUNCE:
@@ -167,14 +558,23 @@ void MasterServer::MasterThread()
 					BitStream query(packet->data, packet->length, false);
 					query.IgnoreBytes(sizeof(MessageID));
 
-					bool announce;
-					query.Read(announce);
+					bool announce = false;
 
-					map<SystemAddress, ServerEntry>::iterator i;
-					i = serverList.find(packet->systemAddress);
+					if (!query.Read(announce))
+						break;
 
 					if (announce)
 					{
+						Time now = GetTime();
+						auto seen = serverSeen.find(packet->systemAddress);
+
+						if (seen != serverSeen.end() && (now - seen->second) < MASTER_ANNOUNCE_RATE)
+						{
+							Utils::timestamp();
+							printf("Announce dropped, rate exceeded (%s)\n", packet->systemAddress.ToString());
+							break;
+						}
+
 						RakString name, map;
 						unsigned int players, playersMax, rsize, msize;
 
@@ -184,60 +584,83 @@ void MasterServer::MasterThread()
 						query.Read(playersMax);
 						query.Read(rsize);
 
-						ServerEntry* entry;
+						auto i = registry.servers.find(packet->systemAddress);
+						ServerEntry entry = i != registry.servers.end() ? i->second->entry : ServerEntry(name.C_String(), map.C_String(), make_pair(players, playersMax), 999);
 
-						if (i == serverList.end())
-						{
-							std::pair<std::map<SystemAddress, ServerEntry>::iterator, bool> k;
-							k = serverList.insert(make_pair(packet->systemAddress, ServerEntry(name.C_String(), map.C_String(), make_pair(players, playersMax), 999)));
-							entry = &(k.first)->second;
-						}
-						else
-						{
-							entry = &i->second;
-							entry->SetServerName(name.C_String());
-							entry->SetServerMap(map.C_String());
-							entry->SetServerPlayers(make_pair(players, playersMax));
-						}
+						entry.SetServerName(name.C_String());
+						entry.SetServerMap(map.C_String());
+						entry.SetServerPlayers(make_pair(players, playersMax));
 
 						for (unsigned int j = 0; j < rsize; j++)
 						{
 							RakString key, value;
 							query.Read(key);
 							query.Read(value);
-							entry->SetServerRule(key.C_String(), value.C_String());
+							entry.SetServerRule(key.C_String(), value.C_String());
 						}
 
-						entry->ClearModFiles();
+						entry.ClearModFiles();
 						query.Read(msize);
 
-                        for (unsigned int j = 0; j < msize; j++)
-                        {
-                            RakString mod_name;
-                            query.Read(mod_name);
-                            entry->SetModFiles(mod_name.C_String());
-                        }
+						for (unsigned int j = 0; j < msize; j++)
+						{
+							RakString mod_name;
+							query.Read(mod_name);
+							entry.SetModFiles(mod_name.C_String());
+						}
+
+						CacheServer(packet->systemAddress, entry);
+
+						if (seen != serverSeen.end())
+							serverExpiry.erase(make_pair(seen->second, packet->systemAddress));
+
+						serverSeen[packet->systemAddress] = now;
+						serverExpiry.emplace(now, packet->systemAddress);
 					}
-					else if (i != serverList.end())
-						serverList.erase(i);
+					else
+						RemoveServer(packet->systemAddress);
 
 					Utils::timestamp();
 					printf("Announce processed (%s)\n", packet->systemAddress.ToString());
 					break;
 				}
 			}
+
+			peer->DeallocatePacket(packet);
 		}
 
+		Time now = GetTime();
+
+		ExpireServers(now);
+
+		// announces are batched into one snapshot, copying the registry on every single one would stall the loop
+		if (registryChanged && (now - registryPublished) >= MASTER_PUBLISH_RATE)
+			PublishRegistry();
+
 		this_thread::sleep_for(chrono::milliseconds(1));
 	}
 
+	{
+		lock_guard<mutex> lock(queueLock);
+		queueOpen = false;
+	}
+
+	queueSignal.notify_all();
+
+	for (auto& worker : workers)
+		worker.join();
+
+	workers.clear();
+
 	peer->Shutdown(300);
 	RakPeerInterface::DestroyInstance(peer);
 }
 
-std::thread MasterServer::InitalizeRakNet()
+std::thread MasterServer::InitalizeRakNet(Time ttl, unsigned int connections)
 {
 	thread = true;
+	serverTTL = ttl;
+	MasterServer::connections = connections;
 
 	return std::thread(MasterThread);
 }
@@ -4,9 +4,17 @@
 
 #include <cstdio>
 #include <ctime>
+#include <algorithm>
 #include <map>
+#include <set>
+#include <vector>
+#include <string>
 #include <thread>
 #include <chrono>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 
 #include "../RakNet.hpp"
 
@@ -19,10 +27,57 @@
 #define RAKNET_PORT        1660
 #define RAKNET_CONNECTIONS 128
 
+#define MASTER_SERVER_TTL    30000
+#define MASTER_ANNOUNCE_RATE 1000
+#define MASTER_PUBLISH_RATE  50
+
 using namespace RakNet;
 using namespace std;
 
-typedef map<SystemAddress, ServerEntry> ServerMap;
+typedef set<SystemAddress> ServerSet;
+
+/**
+ * \brief A server entry along with its wire encoding and the generation it was last changed in
+ */
+struct ServerCached
+{
+	ServerEntry entry;
+	string data;
+	// length of the name, map and player counts at the start of data, the part shared with the dictionary encoding
+	unsigned int head;
+	unsigned int generation;
+};
+
+typedef map<SystemAddress, shared_ptr<const ServerCached>> ServerCache;
+
+/**
+ * \brief The server list and its indexes
+ *
+ * The master thread applies announces to its own registry and periodically publishes an immutable copy.
+ * Query workers only ever read a published copy, entries are shared between copies and replaced instead of modified.
+ */
+struct ServerRegistry
+{
+	ServerCache servers;
+
+	// secondary indexes for filtered queries. interned strings are keyed by address, the servers of the registry keep them alive
+	map<string, ServerSet> mapIndex;
+	map<const string*, ServerSet> modIndex;
+	map<pair<const string*, const string*>, ServerSet> ruleIndex;
+
+	// every announce and removal starts a new generation, so a generation identifies one change.
+	// delta queries walk the servers and the removals in generation order
+	unsigned int generation;
+	map<unsigned int, SystemAddress> changed;
+	map<SystemAddress, unsigned int> removed;
+	map<unsigned int, SystemAddress> removedOrder;
+	unsigned int removedPruned;
+
+	// wire encoding of the unfiltered query response, only built for published copies
+	string query;
+
+	ServerRegistry() : generation(0), removedPruned(0) {}
+};
 
 class MasterServer
 {
@@ -31,14 +86,48 @@ class MasterServer
 		static RakPeerInterface* peer;
 		static SocketDescriptor* sockdescr;
 
-		static ServerMap serverList;
+		// owned by the master thread
+		static ServerRegistry registry;
+		static bool registryChanged;
+		static Time registryPublished;
+		static constexpr unsigned int MAX_REMOVED = 4096;
+
+		// time of the last accepted announce per address, and the listed servers ordered by it for expiry
+		static map<SystemAddress, Time> serverSeen;
+		static set<pair<Time, SystemAddress>> serverExpiry;
+		static Time serverTTL;
+		static unsigned int connections;
+
+		// the latest published registry, swapped atomically
+		static shared_ptr<const ServerRegistry> published;
+
+		// queries waiting for a worker
+		static mutex queueLock;
+		static condition_variable queueSignal;
+		static deque<Packet*> queries;
+		static bool queueOpen;
+		static vector<std::thread> workers;
+
 		static void RemoveServer(SystemAddress addr);
+		static void IndexServer(SystemAddress addr, const ServerEntry& entry, bool index);
+		static void CacheServer(SystemAddress addr, const ServerEntry& entry);
+		static void ExpireServers(Time now);
+		static void PublishRegistry();
+
+		static void FilterServerQuery(BitStream& query, const ServerRegistry& snapshot, const ServerQuery& filter);
+		static void ProcessQuery(Packet* packet, const ServerRegistry& snapshot);
 
 		static void MasterThread();
+		static void WorkerThread();
 		static bool thread;
 
 	public:
-		static std::thread InitalizeRakNet();
+		/**
+		 * \brief Starts the master thread. Listed servers which haven't announced for ttl milliseconds are removed
+		 *
+		 * Every listed server keeps a connection, so connections bounds the number of servers plus querying clients
+		 */
+		static std::thread InitalizeRakNet(Time ttl = MASTER_SERVER_TTL, unsigned int connections = RAKNET_CONNECTIONS);
 		static void TerminateThread();
 
 };
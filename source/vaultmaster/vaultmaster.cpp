@@ -18,14 +18,18 @@ void InputThread()
 	MasterServer::TerminateThread();
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+	// optional arguments: seconds after which a server that stopped announcing is removed, and the maximum number of connections
+	Time ttl = argc > 1 ? strtoul(argv[1], nullptr, 10) * 1000 : MASTER_SERVER_TTL;
+	unsigned int connections = argc > 2 ? strtoul(argv[2], nullptr, 10) : RAKNET_CONNECTIONS;
+
 	printf("Vault-Tec MasterServer %s \n----------------------------------------------------------\n", MASTER_VERSION);
 
 	Utils::timestamp();
 	printf("Initializing RakNet...\n");
 
-	thread hMasterThread = MasterServer::InitalizeRakNet();
+	thread hMasterThread = MasterServer::InitalizeRakNet(ttl ? ttl : MASTER_SERVER_TTL, connections ? connections : RAKNET_CONNECTIONS);
 	thread hInputThread = thread(InputThread);
 
 	hMasterThread.join();
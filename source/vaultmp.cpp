@@ -759,6 +759,24 @@ LRESULT CALLBACK WindowProcedure(HWND hwnd, UINT message, WPARAM wParam, LPARAM
 							bool lock = false;
 							Packet* packet;
 
+							// the whole list in the dictionary encoding, rule and mod names are sent once per page.
+							// a page ends early when its dictionary is full, the next one starts at the cursor
+							unsigned int cursor = 0;
+
+							auto query_page = [&cursor](BitStream& query) {
+								RakString any;
+								query.Write((MessageID) ID_MASTER_QUERY);
+								query.Write(0u);
+								query.Write(cursor);
+								query.Write(0u);
+								query.Write(static_cast<unsigned char>(ServerQuery::SortNone));
+								query.Write(static_cast<unsigned char>(ServerQuery::Dictionary));
+								query.Write(any);
+								query.Write(any);
+								query.Write(0u);
+								query.Write(0u);
+							};
+
 							while (query_state)
 							{
 								for (packet = peer->Receive(); packet; peer->DeallocatePacket(packet), packet = peer->Receive())
@@ -785,7 +803,7 @@ LRESULT CALLBACK WindowProcedure(HWND hwnd, UINT message, WPARAM wParam, LPARAM
 												query.Write(addr);
 											}
 											else
-												query.Write((MessageID) ID_MASTER_QUERY);
+												query_page(query);
 
 											peer->Send(&query, HIGH_PRIORITY, RELIABLE, 0, packet->systemAddress, false, 0);
 											break;
@@ -799,6 +817,18 @@ LRESULT CALLBACK WindowProcedure(HWND hwnd, UINT message, WPARAM wParam, LPARAM
 											unsigned int size;
 											query.Read(size);
 
+											unsigned short dsize;
+											query.Read(dsize);
+
+											vector<string> dictionary(dsize);
+
+											for (auto& str : dictionary)
+											{
+												RakString value;
+												query.Read(value);
+												str = value.C_String();
+											}
+
 											SendMessage(wndprogressbar, PBM_SETPOS, 0, 0);
 											SendMessage(wndprogressbar, PBM_SETRANGE, 0, MAKELONG(0, size));
 											SendMessage(wndprogressbar, PBM_SETSTEP, 1, 0);
@@ -807,7 +837,8 @@ LRESULT CALLBACK WindowProcedure(HWND hwnd, UINT message, WPARAM wParam, LPARAM
 											{
 												SystemAddress addr;
 												RakString name, map;
-												unsigned int players, playersMax, rsize, msize;
+												unsigned int players, playersMax;
+												unsigned short rsize, msize, key, value;
 
 												query.Read(addr);
 												query.Read(name);
@@ -820,19 +851,22 @@ LRESULT CALLBACK WindowProcedure(HWND hwnd, UINT message, WPARAM wParam, LPARAM
 
 												for (unsigned int j = 0; j < rsize; j++)
 												{
-													RakString key, value;
 													query.Read(key);
 													query.Read(value);
-													entry.SetServerRule(key.C_String(), value.C_String());
+
+													// indexes come from the network, a malformed reply must not read past the dictionary
+													if (key < dictionary.size() && value < dictionary.size())
+														entry.SetServerRule(dictionary[key], dictionary[value]);
 												}
 
 												query.Read(msize);
 
 												for (unsigned int j = 0; j < msize; j++)
 												{
-												    RakString mod_name;
-												    query.Read(mod_name);
-												    entry.SetModFiles(mod_name.C_String());
+													query.Read(key);
+
+													if (key < dictionary.size())
+														entry.SetModFiles(dictionary[key]);
 												}
 
 												SystemAddress self = peer->GetExternalID(packet->systemAddress);
@@ -850,6 +884,18 @@ LRESULT CALLBACK WindowProcedure(HWND hwnd, UINT message, WPARAM wParam, LPARAM
 												SendMessage(wndprogressbar, PBM_STEPIT, 0, 0);
 											}
 
+											unsigned int total;
+											cursor += size;
+
+											// a page cut short by its dictionary leaves servers after the cursor, an empty page would repeat forever
+											if (size && query.Read(total) && cursor < total)
+											{
+												BitStream next;
+												query_page(next);
+												peer->Send(&next, HIGH_PRIORITY, RELIABLE, 0, packet->systemAddress, false, 0);
+												break;
+											}
+
 											peer->CloseConnection(packet->systemAddress, true, 0, LOW_PRIORITY);
 											break;
 										}
@@ -1094,21 +1140,21 @@ LRESULT CALLBACK WindowProcedure(HWND hwnd, UINT message, WPARAM wParam, LPARAM
 						if (i != serverList.end())
 						{
 							ServerEntry* entry = &i->second;
-							const map<string, string>& rules = entry->GetServerRules();
+							const ServerEntry::Rules& rules = entry->GetServerRules();
 
 							for (const auto& k : rules)
 							{
-								const string& key = k.first;
-								const string& value = k.second;
+								const string& key = *k.key;
+								const string& value = *k.value;
 								Create2ColItem(wndlistview2, key.c_str(), value.c_str());
 							}
 
 							string value;
 
-							const vector<string>& modfiles = entry->GetServerModFiles();
+							const ServerEntry::ModFiles& modfiles = entry->GetServerModFiles();
 
 							for (const auto& k : modfiles)
-								value += k + ",";
+								value += *k + ",";
 
 							if (!value.empty())
 								Create2ColItem(wndlistview2, "mods", value.c_str());
@@ -9,7 +9,7 @@
 #endif
 
 #define DEDICATED_VERSION "0.1a snapshot \"Gary 2.10\""
-#define MASTER_VERSION "0.1a snapshot \"Gary 2.10\""
+#define MASTER_VERSION "0.1a snapshot \"Gary 2.11\""
 #define CLIENT_VERSION "0.1a snapshot \"Gary 2.10\""
 
 static const unsigned int FALLOUT3_EN_VER17            =   0x00E59528;
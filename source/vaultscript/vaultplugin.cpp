@@ -299,48 +299,6 @@ Void VAULTSCRIPT OnSpawn(ID object) noexcept
 	}
 }
 
-Void VAULTSCRIPT OnActivate(ID object, ID actor) noexcept
-{
-	Container container(object);
-	Player player(actor);
-
-	if (container && player && container.GetLock() == Lock::Unlocked && !IsCViewOpen(actor, object))
-	{
-		auto cview = CView::Create(actor, object, OnItemMove, FormatItemCView);
-		open_cviews.emplace(cview, actor);
-		cview_map.emplace(cview, object);
-		player.AttachWindow(cview);
-
-		constexpr Interval interval = static_cast<Interval>(500);
-		CreateTimerEx(Timer_CloseCView, interval, actor, cview);
-	}
-}
-
-Void VAULTSCRIPT OnCellChange(ID object, CELL cell) noexcept
-{
-
-}
-
-Void VAULTSCRIPT OnLockChange(ID object, ID actor, Lock lock) noexcept
-{
-
-}
-
-Void VAULTSCRIPT OnItemCountChange(ID item, UCount count) noexcept
-{
-
-}
-
-Void VAULTSCRIPT OnItemConditionChange(ID item, Value condition) noexcept
-{
-
-}
-
-Void VAULTSCRIPT OnItemEquippedChange(ID item, State equipped) noexcept
-{
-
-}
-
 Result VAULTSCRIPT OnItemPickup(ID item, ID actor) noexcept
 {
 	return static_cast<Result>(True);
@@ -351,26 +309,6 @@ Result VAULTSCRIPT OnItemMove(ID cview, ID item, ID destination, ID player) noex
 	return static_cast<Result>(True);
 }
 
-Void VAULTSCRIPT OnActorValueChange(ID actor, ActorValue index, Value value) noexcept
-{
-
-}
-
-Void VAULTSCRIPT OnActorBaseValueChange(ID actor, ActorValue index, Value value) noexcept
-{
-
-}
-
-Void VAULTSCRIPT OnActorAlert(ID actor, State alerted) noexcept
-{
-
-}
-
-Void VAULTSCRIPT OnActorSneak(ID actor, State sneaking) noexcept
-{
-
-}
-
 Void VAULTSCRIPT OnActorDeath(ID actor, ID killer, Limb limbs, Death cause) noexcept
 {
 	constexpr Interval delete_after_ms = static_cast<Interval>(10000);
@@ -379,12 +317,30 @@ Void VAULTSCRIPT OnActorDeath(ID actor, ID killer, Limb limbs, Death cause) noex
 		CreateTimerEx(Timer_RemoveActor, delete_after_ms, actor);
 }
 
-Void VAULTSCRIPT OnActorPunch(ID actor, State power) noexcept
-{
-
-}
-
-Void VAULTSCRIPT OnActorFireWeapon(ID actor, WEAP weapon) noexcept
+Void VAULTSCRIPT OnEventBatch(const Event* events, UCount count) noexcept
 {
-
+	for (const Event* event = events; event != events + count; ++event)
+		switch (event->type)
+		{
+			case EventType::Activation:
+			{
+				Container container(event->id);
+				Player player(event->other);
+
+				if (container && player && container.GetLock() == Lock::Unlocked && !IsCViewOpen(event->other, event->id))
+				{
+					auto cview = CView::Create(event->other, event->id, OnItemMove, FormatItemCView);
+					open_cviews.emplace(cview, event->other);
+					cview_map.emplace(cview, event->id);
+					player.AttachWindow(cview);
+
+					constexpr Interval interval = static_cast<Interval>(500);
+					CreateTimerEx(Timer_CloseCView, interval, event->other, cview);
+				}
+				break;
+			}
+
+			default:
+				break;
+		}
 }
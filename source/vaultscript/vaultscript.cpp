@@ -30,6 +30,7 @@ extern "C" {
 	VAULTSCRIPT VAULTSPACE State (*VAULTAPI(ChatMessage))(VAULTSPACE ID, VAULTSPACE cRawString) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(SetRespawnTime))(VAULTSPACE Interval) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(SetSpawnCell))(VAULTSPACE CELL) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE State (*VAULTAPI(LoadCell))(VAULTSPACE CELL) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(SetConsoleEnabled))(VAULTSPACE State) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(SetGameWeather))(VAULTSPACE WTHR) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(SetGameTime))(VAULTSPACE Time) VAULTCPP(noexcept);
@@ -60,7 +61,7 @@ extern "C" {
 	VAULTSCRIPT VAULTSPACE Type (*VAULTAPI(GetType))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetConnection))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetCount))(VAULTSPACE Type) VAULTCPP(noexcept);
-	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetList))(VAULTSPACE Type, VAULTSPACE RawArray(VAULTSPACE ID)*) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetList))(VAULTSPACE Type, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Interval (*VAULTAPI(GetRespawnTime))() VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE CELL (*VAULTAPI(GetSpawnCell))() VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetConsoleEnabled))() VAULTCPP(noexcept);
@@ -76,12 +77,16 @@ extern "C" {
 	VAULTSCRIPT VAULTSPACE Ref (*VAULTAPI(GetReference))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Base (*VAULTAPI(GetBase))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(GetPos))(VAULTSPACE ID, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetPosBatch))(const VAULTSPACE ID*, VAULTSPACE UCount, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(GetAngle))(VAULTSPACE ID, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE CELL (*VAULTAPI(GetCell))(VAULTSPACE ID) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetCellBatch))(const VAULTSPACE ID*, VAULTSPACE UCount, VAULTSPACE CELL*) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Lock (*VAULTAPI(GetLock))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE NPC_ (*VAULTAPI(GetOwner))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE cRawString (*VAULTAPI(GetBaseName))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE State (*VAULTAPI(IsNearPoint))(VAULTSPACE ID, VAULTSPACE Value, VAULTSPACE Value, VAULTSPACE Value, VAULTSPACE Value) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetObjectsInRadius))(VAULTSPACE CELL, VAULTSPACE Value, VAULTSPACE Value, VAULTSPACE Value, VAULTSPACE Value, VAULTSPACE Type, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetObjectsInCell))(VAULTSPACE CELL, VAULTSPACE Type, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE ID (*VAULTAPI(GetItemContainer))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetItemCount))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Value (*VAULTAPI(GetItemCondition))(VAULTSPACE ID) VAULTCPP(noexcept);
@@ -89,8 +94,9 @@ extern "C" {
 	VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetItemSilent))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetItemStick))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetContainerItemCount))(VAULTSPACE ID, VAULTSPACE Base) VAULTCPP(noexcept);
-	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetContainerItemList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID)*) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetContainerItemList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Value (*VAULTAPI(GetActorValue))(VAULTSPACE ID, VAULTSPACE ActorValue) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetActorValueBatch))(const VAULTSPACE ID*, VAULTSPACE UCount, VAULTSPACE ActorValue, VAULTSPACE Value*) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Value (*VAULTAPI(GetActorBaseValue))(VAULTSPACE ID, VAULTSPACE ActorValue) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE IDLE (*VAULTAPI(GetActorIdleAnimation))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Index (*VAULTAPI(GetActorMovingAnimation))(VAULTSPACE ID) VAULTCPP(noexcept);
@@ -105,7 +111,7 @@ extern "C" {
 	VAULTSCRIPT VAULTSPACE CELL (*VAULTAPI(GetPlayerSpawnCell))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetPlayerConsoleEnabled))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetPlayerWindowCount))(VAULTSPACE ID) VAULTCPP(noexcept);
-	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetPlayerWindowList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID)*) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetPlayerWindowList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE ID (*VAULTAPI(GetPlayerChatboxWindow))(VAULTSPACE ID) VAULTCPP(noexcept);
 
 	VAULTSCRIPT VAULTSPACE ID (*VAULTAPI(CreateObject))(VAULTSPACE Base, VAULTSPACE CELL, VAULTSPACE Value, VAULTSPACE Value, VAULTSPACE Value) VAULTCPP(noexcept);
@@ -156,7 +162,7 @@ extern "C" {
 	VAULTSCRIPT VAULTSPACE ID (*VAULTAPI(GetWindowParent))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE ID (*VAULTAPI(GetWindowRoot))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetWindowChildCount))(VAULTSPACE ID) VAULTCPP(noexcept);
-	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetWindowChildList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID)*) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetWindowChildList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(GetWindowPos))(VAULTSPACE ID, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(GetWindowSize))(VAULTSPACE ID, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetWindowVisible))(VAULTSPACE ID) VAULTCPP(noexcept);
@@ -169,9 +175,9 @@ extern "C" {
 	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetRadioButtonGroup))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetListMultiSelect))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetListItemCount))(VAULTSPACE ID) VAULTCPP(noexcept);
-	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetListItemList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID)*) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetListItemList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetListSelectedItemCount))(VAULTSPACE ID) VAULTCPP(noexcept);
-	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetListSelectedItemList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID)*) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetListSelectedItemList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE ID (*VAULTAPI(GetListItemContainer))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetListItemSelected))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE cRawString (*VAULTAPI(GetListItemText))(VAULTSPACE ID) VAULTCPP(noexcept);
@@ -208,6 +214,19 @@ namespace vaultmp
 {
 	State operator!(State state) { return state ? False : True; }
 
+	template<typename F, typename T>
+	static UCount FillIDVector(F function, T arg, IDVector& data) noexcept {
+		// the list can grow between two calls, retry until it fits
+		UCount size;
+		data.resize(data.capacity());
+
+		while ((size = function(arg, data.data(), data.size())) > data.size())
+			data.resize(size);
+
+		data.resize(size);
+		return size;
+	}
+
 	GlobalChat Chat;
 
 	Void timestamp() noexcept { return VAULTAPI(timestamp)(); }
@@ -246,6 +265,7 @@ namespace vaultmp
 	State ChatMessage(cRawString message) noexcept { return VAULTAPI(ChatMessage)(static_cast<ID>(0), message); }
 	Void SetRespawnTime(Interval interval) noexcept { return VAULTAPI(SetRespawnTime)(interval); }
 	Void SetSpawnCell(CELL cell) noexcept { return VAULTAPI(SetSpawnCell)(cell); }
+	State LoadCell(CELL cell) noexcept { return VAULTAPI(LoadCell)(cell); }
 	Void SetConsoleEnabled(State enabled) noexcept { return VAULTAPI(SetConsoleEnabled)(enabled); }
 	Void SetGameWeather(WTHR weather) noexcept { return VAULTAPI(SetGameWeather)(weather); }
 	Void SetGameTime(Time time) noexcept { return VAULTAPI(SetGameTime)(time); }
@@ -276,10 +296,13 @@ namespace vaultmp
 	Type GetType(ID id) noexcept { return VAULTAPI(GetType)(id); }
 	UCount GetConnection(ID id) noexcept { return VAULTAPI(GetConnection)(id); }
 	UCount GetCount(Type type) noexcept { return VAULTAPI(GetCount)(type); }
+	UCount GetList(Type type, IDVector& data) noexcept { return FillIDVector(VAULTAPI(GetList), type, data); }
 	IDVector GetList(Type type) noexcept {
-		RawArray<ID> data;
-		UCount size = VAULTAPI(GetList)(type, &data);
-		return size ? IDVector(data, data + size) : IDVector();
+		// sized up front, the list is walked once unless it grows in between
+		IDVector data;
+		data.reserve(GetCount(type));
+		GetList(type, data);
+		return data;
 	}
 	Interval GetRespawnTime() noexcept { return VAULTAPI(GetRespawnTime)(); }
 	CELL GetSpawnCell() noexcept { return VAULTAPI(GetSpawnCell)(); }
@@ -296,12 +319,38 @@ namespace vaultmp
 	Ref GetReference(ID id) noexcept { return VAULTAPI(GetReference)(id); }
 	Base GetBase(ID id) noexcept { return VAULTAPI(GetBase)(id); }
 	Void GetPos(ID id, Value& X, Value& Y, Value& Z) noexcept { return VAULTAPI(GetPos)(id, &X, &Y, &Z); }
+	UCount GetPosBatch(const IDVector& ids, ValueVector& X, ValueVector& Y, ValueVector& Z) noexcept {
+		X.resize(ids.size());
+		Y.resize(ids.size());
+		Z.resize(ids.size());
+		return VAULTAPI(GetPosBatch)(ids.data(), ids.size(), X.data(), Y.data(), Z.data());
+	}
 	Void GetAngle(ID id, Value& X, Value& Y, Value& Z) noexcept { return VAULTAPI(GetAngle)(id, &X, &Y, &Z); }
 	CELL GetCell(ID id) noexcept { return VAULTAPI(GetCell)(id); }
+	UCount GetCellBatch(const IDVector& ids, std::vector<CELL>& cells) noexcept {
+		cells.resize(ids.size());
+		return VAULTAPI(GetCellBatch)(ids.data(), ids.size(), cells.data());
+	}
 	Lock GetLock(ID id) noexcept { return VAULTAPI(GetLock)(id); }
 	NPC_ GetOwner(ID id) noexcept { return VAULTAPI(GetOwner)(id); }
 	String GetBaseName(ID id) noexcept { return String(VAULTAPI(GetBaseName)(id)); }
 	State IsNearPoint(ID id, Value X, Value Y, Value Z, Value R) noexcept { return VAULTAPI(IsNearPoint)(id, X, Y, Z, R); }
+	UCount GetObjectsInRadius(CELL cell, Value X, Value Y, Value Z, Value R, Type type, IDVector& data) noexcept {
+		return FillIDVector([X, Y, Z, R, type](CELL cell, ID* data, UCount size) { return VAULTAPI(GetObjectsInRadius)(cell, X, Y, Z, R, type, data, size); }, cell, data);
+	}
+	IDVector GetObjectsInRadius(CELL cell, Value X, Value Y, Value Z, Value R, Type type) noexcept {
+		IDVector data;
+		GetObjectsInRadius(cell, X, Y, Z, R, type, data);
+		return data;
+	}
+	UCount GetObjectsInCell(CELL cell, Type type, IDVector& data) noexcept {
+		return FillIDVector([type](CELL cell, ID* data, UCount size) { return VAULTAPI(GetObjectsInCell)(cell, type, data, size); }, cell, data);
+	}
+	IDVector GetObjectsInCell(CELL cell, Type type) noexcept {
+		IDVector data;
+		GetObjectsInCell(cell, type, data);
+		return data;
+	}
 	ID GetItemContainer(ID id) noexcept { return VAULTAPI(GetItemContainer)(id); }
 	UCount GetItemCount(ID id) noexcept { return VAULTAPI(GetItemCount)(id); }
 	Value GetItemCondition(ID id) noexcept { return VAULTAPI(GetItemCondition)(id); }
@@ -324,12 +373,17 @@ namespace vaultmp
 	#undef GetContainerItemCount_Template
 
 	UCount GetContainerItemCount(ID id) noexcept { return VAULTAPI(GetContainerItemCount)(id, static_cast<Base>(0)); }
+	UCount GetContainerItemList(ID id, IDVector& data) noexcept { return FillIDVector(VAULTAPI(GetContainerItemList), id, data); }
 	IDVector GetContainerItemList(ID id) noexcept {
-		RawArray<ID> data;
-		UCount size = VAULTAPI(GetContainerItemList)(id, &data);
-		return size ? IDVector(data, data + size) : IDVector();
+		IDVector data;
+		GetContainerItemList(id, data);
+		return data;
 	}
 	Value GetActorValue(ID id, ActorValue index) noexcept { return VAULTAPI(GetActorValue)(id, index); }
+	UCount GetActorValueBatch(const IDVector& ids, ActorValue index, ValueVector& values) noexcept {
+		values.resize(ids.size());
+		return VAULTAPI(GetActorValueBatch)(ids.data(), ids.size(), index, values.data());
+	}
 	Value GetActorBaseValue(ID id, ActorValue index) noexcept { return VAULTAPI(GetActorBaseValue)(id, index); }
 	IDLE GetActorIdleAnimation(ID id) noexcept { return VAULTAPI(GetActorIdleAnimation)(id); }
 	Index GetActorMovingAnimation(ID id) noexcept { return VAULTAPI(GetActorMovingAnimation)(id); }
@@ -344,10 +398,11 @@ namespace vaultmp
 	CELL GetPlayerSpawnCell(ID id) noexcept { return VAULTAPI(GetPlayerSpawnCell)(id); }
 	State GetPlayerConsoleEnabled(ID id) noexcept { return VAULTAPI(GetPlayerConsoleEnabled)(id); }
 	UCount GetPlayerWindowCount(ID id) noexcept { return VAULTAPI(GetPlayerWindowCount)(id); }
+	UCount GetPlayerWindowList(ID id, IDVector& data) noexcept { return FillIDVector(VAULTAPI(GetPlayerWindowList), id, data); }
 	IDVector GetPlayerWindowList(ID id) noexcept {
-		RawArray<ID> data;
-		UCount size = VAULTAPI(GetPlayerWindowList)(id, &data);
-		return size ? IDVector(data, data + size) : IDVector();
+		IDVector data;
+		GetPlayerWindowList(id, data);
+		return data;
 	}
 	ID GetPlayerChatboxWindow(ID id) noexcept { return VAULTAPI(GetPlayerChatboxWindow)(id); }
 
@@ -507,10 +562,11 @@ namespace vaultmp
 	ID GetWindowParent(ID id) noexcept { return VAULTAPI(GetWindowParent)(id); }
 	ID GetWindowRoot(ID id) noexcept { return VAULTAPI(GetWindowRoot)(id); }
 	UCount GetWindowChildCount(ID id) noexcept { return VAULTAPI(GetWindowChildCount)(id); }
+	UCount GetWindowChildList(ID id, IDVector& data) noexcept { return FillIDVector(VAULTAPI(GetWindowChildList), id, data); }
 	IDVector GetWindowChildList(ID id) noexcept {
-		RawArray<ID> data;
-		UCount size = VAULTAPI(GetWindowChildList)(id, &data);
-		return size ? IDVector(data, data + size) : IDVector();
+		IDVector data;
+		GetWindowChildList(id, data);
+		return data;
 	}
 	Void GetWindowPos(ID id, Value& X, Value& Y, Value& offset_X, Value& offset_Y) noexcept { return VAULTAPI(GetWindowPos)(id, &X, &Y, &offset_X, &offset_Y); }
 	Void GetWindowSize(ID id, Value& X, Value& Y, Value& offset_X, Value& offset_Y) noexcept { return VAULTAPI(GetWindowSize)(id, &X, &Y, &offset_X, &offset_Y); }
@@ -524,16 +580,18 @@ namespace vaultmp
 	UCount GetRadioButtonGroup(ID id) noexcept { return VAULTAPI(GetRadioButtonGroup)(id); }
 	State GetListMultiSelect(ID id) noexcept { return VAULTAPI(GetListMultiSelect)(id); }
 	UCount GetListItemCount(ID id) noexcept { return VAULTAPI(GetListItemCount)(id); }
+	UCount GetListItemList(ID id, IDVector& data) noexcept { return FillIDVector(VAULTAPI(GetListItemList), id, data); }
 	IDVector GetListItemList(ID id) noexcept {
-		RawArray<ID> data;
-		UCount size = VAULTAPI(GetListItemList)(id, &data);
-		return size ? IDVector(data, data + size) : IDVector();
+		IDVector data;
+		GetListItemList(id, data);
+		return data;
 	}
 	UCount GetListSelectedItemCount(ID id) noexcept { return VAULTAPI(GetListSelectedItemCount)(id); }
+	UCount GetListSelectedItemList(ID id, IDVector& data) noexcept { return FillIDVector(VAULTAPI(GetListSelectedItemList), id, data); }
 	IDVector GetListSelectedItemList(ID id) noexcept {
-		RawArray<ID> data;
-		UCount size = VAULTAPI(GetListSelectedItemList)(id, &data);
-		return size ? IDVector(data, data + size) : IDVector();
+		IDVector data;
+		GetListSelectedItemList(id, data);
+		return data;
 	}
 	ID GetListItemContainer(ID id) noexcept { return VAULTAPI(GetListItemContainer)(id); }
 	State GetListItemSelected(ID id) noexcept { return VAULTAPI(GetListItemSelected)(id); }
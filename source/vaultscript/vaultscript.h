@@ -31,7 +31,11 @@
 
 #ifndef __WIN32__
 	#ifndef __cdecl
-		#define __cdecl __attribute__((__cdecl__))
+		#ifdef __i386__
+			#define __cdecl __attribute__((__cdecl__))
+		#else
+			#define __cdecl
+		#endif
 	#endif
 	#define VAULTVAR __attribute__ ((__visibility__("default")))
 #else
@@ -235,6 +239,22 @@ namespace vaultmp {
 	{
 		DEFAULT_PLAYER_RESPAWN = 8000,
 	};
+
+	enum VAULTCPP(class) EventType VAULTCPP(: uint32_t)
+	{
+		Activation = 0, // OnActivate, Activate names the function already
+		CellChange = 1,
+		LockChange = 2,
+		ItemCountChange = 3,
+		ItemConditionChange = 4,
+		ItemEquippedChange = 5,
+		ActorValueChange = 6,
+		ActorBaseValueChange = 7,
+		ActorAlert = 8,
+		ActorSneak = 9,
+		ActorPunch = 10,
+		ActorFireWeapon = 11,
+	};
 #ifndef __cplusplus
 	typedef int8_t Death;
 	typedef uint8_t Reason;
@@ -248,6 +268,7 @@ namespace vaultmp {
 	typedef uint32_t Base;
 	typedef uint32_t Interval;
 	typedef uint32_t Lock;
+	typedef uint32_t EventType;
 	typedef uint64_t ID;
 	typedef uint64_t Timer;
 	typedef uint64_t Result;
@@ -279,6 +300,7 @@ namespace vaultmp {
 	typedef std::string String;
 	typedef std::vector<Base> BaseVector;
 	typedef std::vector<ID> IDVector;
+	typedef std::vector<Value> ValueVector;
 	typedef std::unordered_set<ID, _hash_Base> BaseSet;
 	typedef std::unordered_set<ID, _hash_ID> IDSet;
 
@@ -305,6 +327,22 @@ namespace vaultmp {
 	#define RawFunction(types)	Function<types>
 #endif
 
+	/*
+	 *	Delivered to OnEventBatch once per server tick. A script exporting OnEventBatch
+	 *	receives the events enumerated in EventType this way instead of through their individual callbacks.
+	 *	id is the first argument of the individual callback; other holds a second ID (LockChange: actor),
+	 *	value holds a CELL, Lock, UCount, State, ActorValue or WEAP and number holds a Value.
+	 *	The object may have been destroyed by the time the batch arrives.
+	 */
+	typedef struct
+	{
+		EventType type;
+		ID id;
+		ID other;
+		UCount value;
+		Value number;
+	} Event;
+
 #include "records.h"
 
 VAULTCPP(})
@@ -340,8 +378,10 @@ VAULTCPP(extern "C" {)
 	VAULTSCRIPT VAULTSPACE Void OnListItemSelect(VAULTSPACE ID, VAULTSPACE ID, VAULTSPACE State) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE State OnClientAuthenticate(VAULTSPACE cRawString, VAULTSPACE cRawString) VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Void OnGameTimeChange(VAULTSPACE UCount, VAULTSPACE UCount, VAULTSPACE UCount, VAULTSPACE UCount) VAULTCPP(noexcept);
+	// persistent references of a cell are created when a player first enters it, or by LoadCell. none exist yet in OnServerInit
 	VAULTSCRIPT VAULTSPACE Void OnServerInit() VAULTCPP(noexcept);
 	VAULTSCRIPT VAULTSPACE Void OnServerExit(VAULTSPACE State) VAULTCPP(noexcept);
+	VAULTSCRIPT VAULTSPACE Void OnEventBatch(const VAULTSPACE Event*, VAULTSPACE UCount) VAULTCPP(noexcept);
 
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(timestamp))() VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Timer (*VAULTAPI(CreateTimer))(VAULTSPACE RawFunction(), VAULTSPACE Interval) VAULTCPP(noexcept);
@@ -368,6 +408,7 @@ VAULTCPP(extern "C" {)
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE State (*VAULTAPI(ChatMessage))(VAULTSPACE ID, VAULTSPACE cRawString) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(SetRespawnTime))(VAULTSPACE Interval) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(SetSpawnCell))(VAULTSPACE CELL) VAULTCPP(noexcept);
+	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE State (*VAULTAPI(LoadCell))(VAULTSPACE CELL) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(SetConsoleEnabled))(VAULTSPACE State) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(SetGameWeather))(VAULTSPACE WTHR) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(SetGameTime))(VAULTSPACE Time) VAULTCPP(noexcept);
@@ -398,7 +439,7 @@ VAULTCPP(extern "C" {)
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Type (*VAULTAPI(GetType))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetConnection))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetCount))(VAULTSPACE Type) VAULTCPP(noexcept);
-	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetList))(VAULTSPACE Type, VAULTSPACE RawArray(VAULTSPACE ID)*) VAULTCPP(noexcept);
+	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetList))(VAULTSPACE Type, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Interval (*VAULTAPI(GetRespawnTime))() VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE CELL (*VAULTAPI(GetSpawnCell))() VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetConsoleEnabled))() VAULTCPP(noexcept);
@@ -414,12 +455,16 @@ VAULTCPP(extern "C" {)
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Ref (*VAULTAPI(GetReference))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Base (*VAULTAPI(GetBase))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(GetPos))(VAULTSPACE ID, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*) VAULTCPP(noexcept);
+	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetPosBatch))(const VAULTSPACE ID*, VAULTSPACE UCount, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(GetAngle))(VAULTSPACE ID, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE CELL (*VAULTAPI(GetCell))(VAULTSPACE ID) VAULTCPP(noexcept);
+	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetCellBatch))(const VAULTSPACE ID*, VAULTSPACE UCount, VAULTSPACE CELL*) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Lock (*VAULTAPI(GetLock))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE NPC_ (*VAULTAPI(GetOwner))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE cRawString (*VAULTAPI(GetBaseName))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE State (*VAULTAPI(IsNearPoint))(VAULTSPACE ID, VAULTSPACE Value, VAULTSPACE Value, VAULTSPACE Value, VAULTSPACE Value) VAULTCPP(noexcept);
+	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetObjectsInRadius))(VAULTSPACE CELL, VAULTSPACE Value, VAULTSPACE Value, VAULTSPACE Value, VAULTSPACE Value, VAULTSPACE Type, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
+	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetObjectsInCell))(VAULTSPACE CELL, VAULTSPACE Type, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE ID (*VAULTAPI(GetItemContainer))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetItemCount))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Value (*VAULTAPI(GetItemCondition))(VAULTSPACE ID) VAULTCPP(noexcept);
@@ -427,8 +472,9 @@ VAULTCPP(extern "C" {)
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetItemSilent))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetItemStick))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetContainerItemCount))(VAULTSPACE ID, VAULTSPACE Base) VAULTCPP(noexcept);
-	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetContainerItemList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID)*) VAULTCPP(noexcept);
+	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetContainerItemList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Value (*VAULTAPI(GetActorValue))(VAULTSPACE ID, VAULTSPACE ActorValue) VAULTCPP(noexcept);
+	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetActorValueBatch))(const VAULTSPACE ID*, VAULTSPACE UCount, VAULTSPACE ActorValue, VAULTSPACE Value*) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Value (*VAULTAPI(GetActorBaseValue))(VAULTSPACE ID, VAULTSPACE ActorValue) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE IDLE (*VAULTAPI(GetActorIdleAnimation))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Index (*VAULTAPI(GetActorMovingAnimation))(VAULTSPACE ID) VAULTCPP(noexcept);
@@ -443,7 +489,7 @@ VAULTCPP(extern "C" {)
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE CELL (*VAULTAPI(GetPlayerSpawnCell))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetPlayerConsoleEnabled))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetPlayerWindowCount))(VAULTSPACE ID) VAULTCPP(noexcept);
-	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetPlayerWindowList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID)*) VAULTCPP(noexcept);
+	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetPlayerWindowList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE ID (*VAULTAPI(GetPlayerChatboxWindow))(VAULTSPACE ID) VAULTCPP(noexcept);
 
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE ID (*VAULTAPI(CreateObject))(VAULTSPACE Base, VAULTSPACE CELL, VAULTSPACE Value, VAULTSPACE Value, VAULTSPACE Value) VAULTCPP(noexcept);
@@ -494,7 +540,7 @@ VAULTCPP(extern "C" {)
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE ID (*VAULTAPI(GetWindowParent))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE ID (*VAULTAPI(GetWindowRoot))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetWindowChildCount))(VAULTSPACE ID) VAULTCPP(noexcept);
-	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetWindowChildList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID)*) VAULTCPP(noexcept);
+	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetWindowChildList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(GetWindowPos))(VAULTSPACE ID, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE Void (*VAULTAPI(GetWindowSize))(VAULTSPACE ID, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*, VAULTSPACE Value*) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetWindowVisible))(VAULTSPACE ID) VAULTCPP(noexcept);
@@ -507,9 +553,9 @@ VAULTCPP(extern "C" {)
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetRadioButtonGroup))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetListMultiSelect))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetListItemCount))(VAULTSPACE ID) VAULTCPP(noexcept);
-	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetListItemList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID)*) VAULTCPP(noexcept);
+	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetListItemList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetListSelectedItemCount))(VAULTSPACE ID) VAULTCPP(noexcept);
-	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetListSelectedItemList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID)*) VAULTCPP(noexcept);
+	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE UCount (*VAULTAPI(GetListSelectedItemList))(VAULTSPACE ID, VAULTSPACE RawArray(VAULTSPACE ID), VAULTSPACE UCount) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE ID (*VAULTAPI(GetListItemContainer))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE State (*VAULTAPI(GetListItemSelected))(VAULTSPACE ID) VAULTCPP(noexcept);
 	VAULTCPP(extern) VAULTSCRIPT VAULTSPACE cRawString (*VAULTAPI(GetListItemText))(VAULTSPACE ID) VAULTCPP(noexcept);
@@ -569,18 +615,21 @@ namespace vaultmp
 
 	template<typename... Types>
 	Timer CreateTimerEx(Function<Types...> function, Interval interval, Types... values) noexcept {
+		static_assert(sizeof...(Types) <= 8, "C++ timers and publics take at most 8 arguments");
 		cRawString types = TypeString<Types...>::value;
 		return VAULTAPI(CreateTimerEx)(reinterpret_cast<Function<>>(function), interval, types, values...);
 	}
 
 	template<typename... Types>
 	Void MakePublic(Function<Types...> function, const String& name) noexcept {
+		static_assert(sizeof...(Types) <= 8, "C++ timers and publics take at most 8 arguments");
 		cRawString types = TypeString<Types...>::value;
 		return VAULTAPI(MakePublic)(reinterpret_cast<Function<>>(function), name.c_str(), types);
 	}
 
 	template<typename... Types>
 	Void MakePublic(Function<Types...> function, cRawString name) noexcept {
+		static_assert(sizeof...(Types) <= 8, "C++ timers and publics take at most 8 arguments");
 		cRawString types = TypeString<Types...>::value;
 		return VAULTAPI(MakePublic)(reinterpret_cast<Function<>>(function), name, types);
 	}
@@ -641,6 +690,7 @@ namespace vaultmp
 	VAULTFUNCTION State ChatMessage(cRawString message) noexcept;
 	VAULTFUNCTION Void SetRespawnTime(Interval interval) noexcept;
 	VAULTFUNCTION Void SetSpawnCell(CELL cell) noexcept;
+	VAULTFUNCTION State LoadCell(CELL cell) noexcept;
 	VAULTFUNCTION Void SetConsoleEnabled(State enabled) noexcept;
 	VAULTFUNCTION Void SetGameWeather(WTHR weather) noexcept;
 	VAULTFUNCTION Void SetGameTime(Time time) noexcept;
@@ -672,6 +722,7 @@ namespace vaultmp
 	VAULTFUNCTION UCount GetConnection(ID id) noexcept;
 	VAULTFUNCTION UCount GetCount(Type type) noexcept;
 	VAULTFUNCTION IDVector GetList(Type type) noexcept;
+	VAULTFUNCTION UCount GetList(Type type, IDVector& data) noexcept;
 	VAULTFUNCTION Interval GetRespawnTime() noexcept;
 	VAULTFUNCTION CELL GetSpawnCell() noexcept;
 	VAULTFUNCTION State GetConsoleEnabled() noexcept;
@@ -687,12 +738,18 @@ namespace vaultmp
 	VAULTFUNCTION Ref GetReference(ID id) noexcept;
 	VAULTFUNCTION Base GetBase(ID id) noexcept;
 	VAULTFUNCTION Void GetPos(ID id, Value& X, Value& Y, Value& Z) noexcept;
+	VAULTFUNCTION UCount GetPosBatch(const IDVector& ids, ValueVector& X, ValueVector& Y, ValueVector& Z) noexcept;
 	VAULTFUNCTION Void GetAngle(ID id, Value& X, Value& Y, Value& Z) noexcept;
 	VAULTFUNCTION CELL GetCell(ID id) noexcept;
+	VAULTFUNCTION UCount GetCellBatch(const IDVector& ids, std::vector<CELL>& cells) noexcept;
 	VAULTFUNCTION Lock GetLock(ID id) noexcept;
 	VAULTFUNCTION NPC_ GetOwner(ID id) noexcept;
 	VAULTFUNCTION String GetBaseName(ID id) noexcept;
 	VAULTFUNCTION State IsNearPoint(ID id, Value X, Value Y, Value Z, Value R) noexcept;
+	VAULTFUNCTION IDVector GetObjectsInRadius(CELL cell, Value X, Value Y, Value Z, Value R, Type type = Type::ALL_OBJECTS) noexcept;
+	VAULTFUNCTION UCount GetObjectsInRadius(CELL cell, Value X, Value Y, Value Z, Value R, Type type, IDVector& data) noexcept;
+	VAULTFUNCTION IDVector GetObjectsInCell(CELL cell, Type type = Type::ALL_OBJECTS) noexcept;
+	VAULTFUNCTION UCount GetObjectsInCell(CELL cell, Type type, IDVector& data) noexcept;
 	VAULTFUNCTION ID GetItemContainer(ID id) noexcept;
 	VAULTFUNCTION UCount GetItemCount(ID id) noexcept;
 	VAULTFUNCTION Value GetItemCondition(ID id) noexcept;
@@ -716,7 +773,9 @@ namespace vaultmp
 
 	VAULTFUNCTION UCount GetContainerItemCount(ID id) noexcept;
 	VAULTFUNCTION IDVector GetContainerItemList(ID id) noexcept;
+	VAULTFUNCTION UCount GetContainerItemList(ID id, IDVector& data) noexcept;
 	VAULTFUNCTION Value GetActorValue(ID id, ActorValue index) noexcept;
+	VAULTFUNCTION UCount GetActorValueBatch(const IDVector& ids, ActorValue index, ValueVector& values) noexcept;
 	VAULTFUNCTION Value GetActorBaseValue(ID id, ActorValue index) noexcept;
 	VAULTFUNCTION IDLE GetActorIdleAnimation(ID id) noexcept;
 	VAULTFUNCTION Index GetActorMovingAnimation(ID id) noexcept;
@@ -732,6 +791,7 @@ namespace vaultmp
 	VAULTFUNCTION State GetPlayerConsoleEnabled(ID id) noexcept;
 	VAULTFUNCTION UCount GetPlayerWindowCount(ID id) noexcept;
 	VAULTFUNCTION IDVector GetPlayerWindowList(ID id) noexcept;
+	VAULTFUNCTION UCount GetPlayerWindowList(ID id, IDVector& data) noexcept;
 	VAULTFUNCTION ID GetPlayerChatboxWindow(ID id) noexcept;
 
 	#define CreateObject_Template(type) \
@@ -901,6 +961,7 @@ namespace vaultmp
 	VAULTFUNCTION ID GetWindowRoot(ID id) noexcept;
 	VAULTFUNCTION UCount GetWindowChildCount(ID id) noexcept;
 	VAULTFUNCTION IDVector GetWindowChildList(ID id) noexcept;
+	VAULTFUNCTION UCount GetWindowChildList(ID id, IDVector& data) noexcept;
 	VAULTFUNCTION Void GetWindowPos(ID id, Value& X, Value& Y, Value& offset_X, Value& offset_Y) noexcept;
 	VAULTFUNCTION Void GetWindowSize(ID id, Value& X, Value& Y, Value& offset_X, Value& offset_Y) noexcept;
 	VAULTFUNCTION State GetWindowVisible(ID id) noexcept;
@@ -914,8 +975,10 @@ namespace vaultmp
 	VAULTFUNCTION State GetListMultiSelect(ID id) noexcept;
 	VAULTFUNCTION UCount GetListItemCount(ID id) noexcept;
 	VAULTFUNCTION IDVector GetListItemList(ID id) noexcept;
+	VAULTFUNCTION UCount GetListItemList(ID id, IDVector& data) noexcept;
 	VAULTFUNCTION UCount GetListSelectedItemCount(ID id) noexcept;
 	VAULTFUNCTION IDVector GetListSelectedItemList(ID id) noexcept;
+	VAULTFUNCTION UCount GetListSelectedItemList(ID id, IDVector& data) noexcept;
 	VAULTFUNCTION ID GetListItemContainer(ID id) noexcept;
 	VAULTFUNCTION State GetListItemSelected(ID id) noexcept;
 	VAULTFUNCTION String GetListItemText(ID id) noexcept;
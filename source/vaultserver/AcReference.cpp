@@ -1,5 +1,5 @@
 #include "AcReference.hpp"
-#include "sqlite/sqlite3.h"
+#include "Database.hpp"
 
 #include <cmath>
 
@@ -8,25 +8,25 @@ using namespace DB;
 
 unordered_map<unsigned int, AcReference*> AcReference::refs;
 
-AcReference::AcReference(const string& table, sqlite3_stmt* stmt)
+AcReference::AcReference(const string& table, const DatabaseRow& row)
 {
-	if (sqlite3_column_count(stmt) != 12)
+	if (row.GetColumnCount() != 12)
 		throw VaultException("Malformed input database (actor / creature references): %s", table.c_str()).stacktrace();
 
-	unsigned int dlc = static_cast<unsigned int>(sqlite3_column_int(stmt, 11));
+	unsigned int dlc = static_cast<unsigned int>(row.GetInt(11));
 	// if DLC enabled
 
 	dlc <<= 24;
 
 	constexpr double degrees = 180.0 / M_PI;
 
-	editor = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
-	refID = static_cast<unsigned int>(sqlite3_column_int(stmt, 1));
-	baseID = static_cast<unsigned int>(sqlite3_column_int(stmt, 2));
-	cell = static_cast<unsigned int>(sqlite3_column_int(stmt, 3));
-	pos = make_tuple(sqlite3_column_double(stmt, 4), sqlite3_column_double(stmt, 5), sqlite3_column_double(stmt, 6));
-	angle = make_tuple(sqlite3_column_double(stmt, 7) * degrees, sqlite3_column_double(stmt, 8) * degrees, sqlite3_column_double(stmt, 9) * degrees);
-	flags = static_cast<unsigned int>(sqlite3_column_int(stmt, 10));
+	editor = row.GetText(0);
+	refID = static_cast<unsigned int>(row.GetInt(1));
+	baseID = static_cast<unsigned int>(row.GetInt(2));
+	cell = static_cast<unsigned int>(row.GetInt(3));
+	pos = make_tuple(row.GetDouble(4), row.GetDouble(5), row.GetDouble(6));
+	angle = make_tuple(row.GetDouble(7) * degrees, row.GetDouble(8) * degrees, row.GetDouble(9) * degrees);
+	flags = static_cast<unsigned int>(row.GetInt(10));
 
 	if (refID & 0xFF000000)
 	{
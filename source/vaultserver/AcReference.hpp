@@ -8,7 +8,7 @@
 #include <tuple>
 #include <unordered_map>
 
-class sqlite3_stmt;
+class DatabaseRow;
 
 /**
  * \brief Represents a game creature reference
@@ -43,7 +43,7 @@ namespace DB
 			const std::tuple<float, float, float>& GetAngle() const;
 			unsigned int GetFlags() const;
 
-			AcReference(const std::string& table, sqlite3_stmt* stmt);
+			AcReference(const std::string& table, const DatabaseRow& row);
 			~AcReference() = default;
 			// must never be called. only defined because vector requires it
 			AcReference(AcReference&&) { std::terminate(); }
@@ -1,29 +1,31 @@
 #include "BaseContainer.hpp"
 #include "Record.hpp"
 #include "VaultException.hpp"
-#include "sqlite/sqlite3.h"
+#include "Database.hpp"
 
 #include <algorithm>
 
 using namespace std;
 using namespace DB;
 
-unordered_map<unsigned int, vector<BaseContainer*>> BaseContainer::baseContainers;
+vector<pair<BaseContainer*, bool>> BaseContainer::pending;
+vector<BaseContainer*> BaseContainer::rows;
+FlatIndex<pair<unsigned int, unsigned int>> BaseContainer::ranges;
 
-BaseContainer::BaseContainer(const string& table, sqlite3_stmt* stmt)
+BaseContainer::BaseContainer(const string& table, const DatabaseRow& row)
 {
-	if (sqlite3_column_count(stmt) != 5)
+	if (row.GetColumnCount() != 5)
 		throw VaultException("Malformed input database (base containers): %s", table.c_str()).stacktrace();
 
-	unsigned int dlc = static_cast<unsigned int>(sqlite3_column_int(stmt, 4));
+	unsigned int dlc = static_cast<unsigned int>(row.GetInt(4));
 	// if DLC enabled
 
 	dlc <<= 24;
 
-	baseID = static_cast<unsigned int>(sqlite3_column_int(stmt, 0));
-	item = static_cast<unsigned int>(sqlite3_column_int(stmt, 1));
-	count = static_cast<unsigned int>(sqlite3_column_int(stmt, 2));
-	condition = sqlite3_column_double(stmt, 3) * 100.0;
+	baseID = static_cast<unsigned int>(row.GetInt(0));
+	item = static_cast<unsigned int>(row.GetInt(1));
+	count = static_cast<unsigned int>(row.GetInt(2));
+	condition = row.GetDouble(3) * 100.0;
 
 	if (!condition)
 		condition = 100.0;
@@ -36,23 +38,59 @@ BaseContainer::BaseContainer(const string& table, sqlite3_stmt* stmt)
 
 	// leveld items not implemented yet
 	// STAT, MSTT: some "Test" containers contain illegal stuff
-	if (!Record::Lookup(item)->GetType().compare("LVLI") || !Record::Lookup(item)->GetType().compare("STAT") || !Record::Lookup(item)->GetType().compare("MSTT"))
+	constexpr unsigned int skip = Record::Mask("LVLI", "STAT", "MSTT");
+
+	if (Record::Lookup(item)->GetTypeMask() & skip)
 		return;
 
 	if (baseID & 0xFF000000)
 	{
 		baseID &= 0x00FFFFFF;
 		baseID |= dlc;
+		pending.emplace_back(this, false);
 	}
 	else
-		baseContainers[baseID].erase(remove_if(baseContainers[baseID].begin(), baseContainers[baseID].end(), [this](const BaseContainer* container) { return container->GetItem() == item; }), baseContainers[baseID].end());
+		pending.emplace_back(this, true);
+}
+
+BaseContainer::Span BaseContainer::Lookup(unsigned int baseID)
+{
+	auto range = ranges.Find(baseID);
 
-	baseContainers[baseID].emplace_back(this);
+	if (!range)
+		return {rows.end(), rows.end()};
+
+	return {rows.begin() + range->first, rows.begin() + range->first + range->second};
 }
 
-const vector<BaseContainer*>& BaseContainer::Lookup(unsigned int baseID)
+void BaseContainer::Index()
 {
-	return baseContainers[baseID];
+	stable_sort(pending.begin(), pending.end(), [](const pair<BaseContainer*, bool>& lhs, const pair<BaseContainer*, bool>& rhs) { return lhs.first->baseID < rhs.first->baseID; });
+
+	rows.clear();
+	rows.reserve(pending.size());
+	ranges.Clear();
+
+	for (auto it = pending.begin(); it != pending.end();)
+	{
+		unsigned int baseID = it->first->baseID;
+		unsigned int first = rows.size();
+
+		for (; it != pending.end() && it->first->baseID == baseID; ++it)
+		{
+			unsigned int item = it->first->item;
+
+			if (it->second)
+				rows.erase(remove_if(rows.begin() + first, rows.end(), [item](const BaseContainer* container) { return container->item == item; }), rows.end());
+
+			rows.emplace_back(it->first);
+		}
+
+		ranges.Assign(baseID, {first, rows.size() - first});
+	}
+
+	pending.clear();
+	pending.shrink_to_fit();
 }
 
 unsigned int BaseContainer::GetBase() const
@@ -2,12 +2,12 @@
 #define BASECONTAINERDB_H
 
 #include "vaultserver.hpp"
+#include "FlatIndex.hpp"
 
 #include <vector>
 #include <string>
-#include <unordered_map>
 
-class sqlite3_stmt;
+class DatabaseRow;
 
 /**
  * \brief Represents a base container
@@ -17,8 +17,23 @@ namespace DB
 {
 	class BaseContainer
 	{
+		public:
+			struct Span
+			{
+				std::vector<BaseContainer*>::const_iterator first, last;
+
+				std::vector<BaseContainer*>::const_iterator begin() const { return first; }
+				std::vector<BaseContainer*>::const_iterator end() const { return last; }
+				std::size_t size() const { return last - first; }
+				bool empty() const { return first == last; }
+			};
+
 		private:
-			static std::unordered_map<unsigned int, std::vector<BaseContainer*>> baseContainers;
+			// rows in load order, the flag is set if the row replaces earlier rows of the same item
+			static std::vector<std::pair<BaseContainer*, bool>> pending;
+			// grouped by baseID once indexed, ranges maps a baseID to the offset and length of its group
+			static std::vector<BaseContainer*> rows;
+			static FlatIndex<std::pair<unsigned int, unsigned int>> ranges;
 
 			unsigned int baseID;
 			unsigned int item;
@@ -29,14 +44,18 @@ namespace DB
 			BaseContainer& operator=(const BaseContainer&) = delete;
 
 		public:
-			static const std::vector<BaseContainer*>& Lookup(unsigned int baseID);
+			static Span Lookup(unsigned int baseID);
+			/**
+			 * \brief Groups the loaded rows by base container, must be called once all rows are loaded
+			 */
+			static void Index();
 
 			unsigned int GetBase() const;
 			unsigned int GetItem() const;
 			unsigned int GetCount() const;
 			float GetCondition() const;
 
-			BaseContainer(const std::string& table, sqlite3_stmt* stmt);
+			BaseContainer(const std::string& table, const DatabaseRow& row);
 			~BaseContainer() = default;
 			// must never be called. only defined because vector requires it
 			BaseContainer(BaseContainer&&) { std::terminate(); }
@@ -13,6 +13,10 @@
 #include "AcReference.hpp"
 #include "sqlite/sqlite3.h"
 
+#include <mutex>
+#include <cstdlib>
+#include <sys/stat.h>
+
 #ifdef __WIN32__
 	#include <winsock2.h>
 	#include <io.h>
@@ -28,6 +32,67 @@ template <typename T>
 DebugInput<Database<T>> Database<T>::debug;
 #endif
 
+static once_flag stale;
+
+unsigned int DatabaseRow::GetColumnCount() const
+{
+	return stmt ? sqlite3_column_count(stmt) : table->columns;
+}
+
+signed int DatabaseRow::GetInt(unsigned int column) const
+{
+	if (stmt)
+		return sqlite3_column_int(stmt, column);
+
+	if (column >= table->columns)
+		return 0;
+
+	switch (image->GetTypes(table)[column])
+	{
+		case DatabaseImage::Integer:
+			return static_cast<signed int>(cells[column].integer);
+
+		case DatabaseImage::Real:
+			return static_cast<signed int>(static_cast<long long>(cells[column].real));
+
+		default:
+			return atoi(image->GetString(cells[column].text));
+	}
+}
+
+double DatabaseRow::GetDouble(unsigned int column) const
+{
+	if (stmt)
+		return sqlite3_column_double(stmt, column);
+
+	if (column >= table->columns)
+		return 0.0;
+
+	switch (image->GetTypes(table)[column])
+	{
+		case DatabaseImage::Integer:
+			return static_cast<double>(cells[column].integer);
+
+		case DatabaseImage::Real:
+			return cells[column].real;
+
+		default:
+			return atof(image->GetString(cells[column].text));
+	}
+}
+
+const char* DatabaseRow::GetText(unsigned int column) const
+{
+	if (stmt)
+		return reinterpret_cast<const char*>(sqlite3_column_text(stmt, column));
+
+	// the compiler stores every column holding text as text
+	if (column >= table->columns || image->GetTypes(table)[column] != DatabaseImage::Text)
+		return "";
+
+	return image->GetString(cells[column].text);
+}
+
 template <typename T>
 unsigned int Database<T>::initialize(const string& file, const vector<string>& tables)
 {
@@ -42,6 +107,19 @@ unsigned int Database<T>::initialize(const string& file, const vector<string>& t
 	char _file[MAX_PATH];
 	snprintf(_file, sizeof(_file), "%s/%s/%s", base, DATA_PATH, file.c_str());
 
+	string _image = DatabaseImage::GetPath(_file);
+	struct stat info;
+
+	if (stat(_image.c_str(), &info) == 0)
+	{
+		DatabaseImage image(_image);
+
+		if (image.IsCurrentFor(_file))
+			return initialize(image, DatabaseImage::GetPath(file), tables);
+
+		call_once(stale, [&_image, &file]() { printf("Database image %s is out of date, reading %s instead\n", _image.c_str(), file.c_str()); });
+	}
+
 	sqlite3* db;
 
 	if (sqlite3_open_v2(_file, &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
@@ -82,10 +160,6 @@ unsigned int Database<T>::initialize(const string& file, const vector<string>& t
 
 	data.reserve(count);
 
-	double end = 0.0;
-	double delta = 100.0 / count;
-	printf("Reading database %s (%s, ...)\n", file.c_str(), tables.front().c_str());
-
 	for (const string& table : tables)
 	{
 		query = "SELECT * FROM " + table;
@@ -106,11 +180,6 @@ unsigned int Database<T>::initialize(const string& file, const vector<string>& t
 
 		do
 		{
-			if (static_cast<unsigned int>(end + delta) > static_cast<unsigned int>(end))
-				Utils::progress_func(100.0, end);
-
-			end += delta;
-
 			if (ret != SQLITE_ROW)
 			{
 				sqlite3_finalize(stmt);
@@ -120,7 +189,7 @@ unsigned int Database<T>::initialize(const string& file, const vector<string>& t
 
 			try
 			{
-				data.emplace_back(table, stmt);
+				data.emplace_back(table, DatabaseRow(stmt));
 			}
 			catch (...)
 			{
@@ -135,6 +204,9 @@ unsigned int Database<T>::initialize(const string& file, const vector<string>& t
 
 	sqlite3_close(db);
 
+	// databases are read concurrently, a single line per database does not interleave like a progress bar would
+	printf("Read %u records from database %s (%s, ...)\n", static_cast<unsigned int>(data.size()), file.c_str(), tables.front().c_str());
+
 #ifdef VAULTMP_DEBUG
 	debug.print("Successfully read ", dec, data.size(), " records (", typeid(T).name(), ") from ", _file);
 #endif
@@ -142,6 +214,38 @@ unsigned int Database<T>::initialize(const string& file, const vector<string>& t
 	return data.size();
 }
 
+template <typename T>
+unsigned int Database<T>::initialize(const DatabaseImage& image, const string& file, const vector<string>& tables)
+{
+	vector<const DatabaseImage::Table*> _tables;
+	unsigned int count = 0;
+
+	for (const string& table : tables)
+	{
+		const DatabaseImage::Table* _table = image.GetTable(table);
+
+		if (!_table)
+			throw VaultException("Could not find table %s in database image %s", table.c_str(), file.c_str()).stacktrace();
+
+		_tables.emplace_back(_table);
+		count += _table->rows;
+	}
+
+	data.reserve(count);
+
+	for (unsigned int i = 0; i < tables.size(); ++i)
+		for (unsigned int row = 0; row < _tables[i]->rows; ++row)
+			data.emplace_back(tables[i], DatabaseRow(&image, _tables[i], row));
+
+	printf("Read %u records from database image %s (%s, ...)\n", static_cast<unsigned int>(data.size()), file.c_str(), tables.front().c_str());
+
+#ifdef VAULTMP_DEBUG
+	debug.print("Successfully read ", dec, data.size(), " records (", typeid(T).name(), ") from ", file.c_str());
+#endif
+
+	return data.size();
+}
+
 template class Database<DB::Record>;
 template class Database<DB::Reference>;
 template class Database<DB::Exterior>;
@@ -7,11 +7,41 @@
 #include "Debug.hpp"
 #endif
 
+#include "DatabaseImage.hpp"
+
 #include <string>
 #include <vector>
 
+class sqlite3_stmt;
+
+/**
+ * \brief A row of a database table, read either from SQLite3 or from a database image
+ *
+ * Columns are converted like the sqlite3_column functions do, an out of range column reads as 0 or an empty string.
+ */
+
+class DatabaseRow
+{
+	private:
+		sqlite3_stmt* stmt;
+		const DatabaseImage* image;
+		const DatabaseImage::Table* table;
+		const DatabaseImage::Cell* cells;
+
+	public:
+		DatabaseRow(sqlite3_stmt* stmt) : stmt(stmt), image(nullptr), table(nullptr), cells(nullptr) {}
+		DatabaseRow(const DatabaseImage* image, const DatabaseImage::Table* table, unsigned int row) : stmt(nullptr), image(image), table(table), cells(image->GetRow(table, row)) {}
+
+		unsigned int GetColumnCount() const;
+		signed int GetInt(unsigned int column) const;
+		double GetDouble(unsigned int column) const;
+		const char* GetText(unsigned int column) const;
+};
+
 /**
  * \brief Used to access vaultmp SQLite3 databases
+ *
+ * A database image compiled by tools/dbimage is read instead of the database when one is present and up to date.
  */
 
 template<typename T>
@@ -30,6 +60,7 @@ class Database
 		~Database() = default;
 
 		unsigned int initialize(const std::string& file, const std::vector<std::string>& tables);
+		unsigned int initialize(const DatabaseImage& image, const std::string& file, const std::vector<std::string>& tables);
 };
 
 #endif
@@ -0,0 +1,143 @@
+#include "DatabaseImage.hpp"
+#include "VaultException.hpp"
+
+#include <cstring>
+#include <sys/stat.h>
+
+#ifdef __WIN32__
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+constexpr uint32_t DatabaseImage::MAGIC;
+constexpr uint32_t DatabaseImage::VERSION;
+constexpr const char* DatabaseImage::EXTENSION;
+
+DatabaseImage::DatabaseImage(const string& path) : base(nullptr), size(0), header(nullptr), tables(nullptr)
+{
+#ifdef __WIN32__
+	file = CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	mapping = nullptr;
+
+	if (file == INVALID_HANDLE_VALUE)
+		throw VaultException("Could not open database image %s", path.c_str()).stacktrace();
+
+	LARGE_INTEGER length;
+
+	if (GetFileSizeEx(file, &length))
+		size = length.QuadPart;
+
+	if (size)
+		mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (mapping)
+		base = reinterpret_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+	if (!base)
+	{
+		if (mapping)
+			CloseHandle(mapping);
+
+		CloseHandle(file);
+		throw VaultException("Could not map database image %s", path.c_str()).stacktrace();
+	}
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+
+	if (fd == -1)
+		throw VaultException("Could not open database image %s", path.c_str()).stacktrace();
+
+	struct stat info;
+
+	if (fstat(fd, &info) == 0)
+		size = info.st_size;
+
+	void* address = size ? mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+	close(fd);
+
+	if (address == MAP_FAILED)
+		throw VaultException("Could not map database image %s", path.c_str()).stacktrace();
+
+	base = reinterpret_cast<const char*>(address);
+	// rows are read once from start to end
+	madvise(address, size, MADV_SEQUENTIAL);
+#endif
+
+	header = reinterpret_cast<const Header*>(base);
+	tables = reinterpret_cast<const Table*>(base + sizeof(Header));
+
+	auto fits = [this](uint64_t offset, uint64_t length) { return offset <= size && length <= size - offset; };
+
+	bool valid = size >= sizeof(Header) && header->magic == MAGIC && header->version == VERSION
+		&& fits(sizeof(Header), static_cast<uint64_t>(header->tables) * sizeof(Table))
+		&& header->strings_size && fits(header->strings, header->strings_size) && !base[header->strings + header->strings_size - 1];
+
+	for (uint32_t i = 0; valid && i < header->tables; ++i)
+	{
+		const Table& table = tables[i];
+
+		valid = table.name < header->strings_size && fits(table.types, table.columns) && !(table.cells % sizeof(Cell))
+			&& (!table.columns || table.rows <= (size / sizeof(Cell)) / table.columns)
+			&& fits(table.cells, static_cast<uint64_t>(table.rows) * table.columns * sizeof(Cell));
+
+		for (uint32_t j = 0; valid && j < table.columns; ++j)
+			valid = GetTypes(&table)[j] >= Integer && GetTypes(&table)[j] <= Text;
+	}
+
+	if (!valid)
+	{
+		Unmap();
+		throw VaultException("Malformed database image or wrong version: %s", path.c_str()).stacktrace();
+	}
+}
+
+DatabaseImage::~DatabaseImage()
+{
+	Unmap();
+}
+
+void DatabaseImage::Unmap() noexcept
+{
+	if (!base)
+		return;
+
+#ifdef __WIN32__
+	UnmapViewOfFile(base);
+	CloseHandle(mapping);
+	CloseHandle(file);
+#else
+	munmap(const_cast<char*>(base), size);
+#endif
+
+	base = nullptr;
+}
+
+string DatabaseImage::GetPath(const string& database)
+{
+	return database.substr(0, database.rfind('.')) + EXTENSION;
+}
+
+bool DatabaseImage::IsCurrentFor(const string& database) const
+{
+	struct stat info;
+
+	// an image shipped without its database is always used
+	if (stat(database.c_str(), &info) != 0)
+		return true;
+
+	return header->source_size == static_cast<uint64_t>(info.st_size) && header->source_mtime == static_cast<int64_t>(info.st_mtime);
+}
+
+const DatabaseImage::Table* DatabaseImage::GetTable(const string& name) const
+{
+	for (uint32_t i = 0; i < header->tables; ++i)
+		if (!strcmp(GetString(tables[i].name), name.c_str()))
+			return &tables[i];
+
+	return nullptr;
+}
@@ -0,0 +1,105 @@
+#ifndef DATABASEIMAGE_H
+#define DATABASEIMAGE_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * \brief A read-only memory mapping of a compiled vaultmp SQLite3 database
+ *
+ * tools/dbimage compiles every table of a database into one file: a header, a table directory, and for each table
+ * its column types and its rows as 8 byte cells, in the order SQLite returns them. Strings are stored once in a pool
+ * of null-terminated strings, text cells hold their offset into it. All fields are little-endian and 8 byte aligned.
+ */
+
+class DatabaseImage
+{
+	public:
+		static constexpr uint32_t MAGIC = 0x42444D56; // "VMDB"
+		static constexpr uint32_t VERSION = 1;
+		static constexpr const char* EXTENSION = ".vmdb";
+
+		enum Type : uint8_t
+		{
+			Integer = 1,
+			Real = 2,
+			Text = 3,
+		};
+
+		union Cell
+		{
+			int64_t integer;
+			double real;
+			uint64_t text;
+		};
+
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t tables;
+			uint32_t reserved;
+			// size and modification time of the database the image was compiled from
+			uint64_t source_size;
+			int64_t source_mtime;
+			uint64_t strings;
+			uint64_t strings_size;
+		};
+
+		struct Table
+		{
+			uint32_t name;
+			uint32_t columns;
+			uint32_t rows;
+			uint32_t reserved;
+			uint64_t types;
+			uint64_t cells;
+		};
+
+	private:
+		const char* base;
+		size_t size;
+		const Header* header;
+		const Table* tables;
+
+#ifdef __WIN32__
+		void* file;
+		void* mapping;
+#endif
+
+		void Unmap() noexcept;
+
+		DatabaseImage(const DatabaseImage&) = delete;
+		DatabaseImage& operator=(const DatabaseImage&) = delete;
+
+	public:
+		/**
+		 * \brief Maps an image, throws a VaultException if it cannot be mapped or is malformed
+		 */
+		DatabaseImage(const std::string& path);
+		~DatabaseImage();
+
+		/**
+		 * \brief Returns the image file name of a database, the database extension replaced with EXTENSION
+		 */
+		static std::string GetPath(const std::string& database);
+
+		/**
+		 * \brief Returns true if the image was compiled from the given database file in its current state
+		 */
+		bool IsCurrentFor(const std::string& database) const;
+
+		/**
+		 * \brief Returns a table by name, or nullptr if the image has none
+		 */
+		const Table* GetTable(const std::string& name) const;
+		const Type* GetTypes(const Table* table) const { return reinterpret_cast<const Type*>(base + table->types); }
+		const Cell* GetRow(const Table* table, unsigned int row) const { return reinterpret_cast<const Cell*>(base + table->cells) + static_cast<size_t>(row) * table->columns; }
+		/**
+		 * \brief Returns a string of the pool, the empty string for an offset out of range
+		 */
+		const char* GetString(uint64_t offset) const { return base + header->strings + (offset < header->strings_size ? offset : 0); }
+};
+
+#endif
@@ -79,23 +79,23 @@ void Dedicated::Announce(bool announce)
 			RakString _map(self->GetServerMap().c_str());
 			unsigned int players = self->GetServerPlayers().first;
 			unsigned int playersMax = self->GetServerPlayers().second;
-			const map<string, string>& rules = self->GetServerRules();
+			const ServerEntry::Rules& rules = self->GetServerRules();
 
 			query.Write(name);
 			query.Write(_map);
 			query.Write(players);
 			query.Write(playersMax);
-			query.Write(rules.size());
+			query.Write(static_cast<unsigned int>(rules.size()));
 
 			for (const auto& i : rules)
 			{
-				RakString key(i.first.c_str());
-				RakString value(i.second.c_str());
+				RakString key(i.key->c_str());
+				RakString value(i.value->c_str());
 				query.Write(key);
 				query.Write(value);
 			}
 
-			query.Write(modfiles.size());
+			query.Write(static_cast<unsigned int>(modfiles.size()));
 
 			for (const auto& j : modfiles)
 			{
@@ -140,23 +140,23 @@ void Dedicated::Query(Packet* packet)
 		RakString _map(self->GetServerMap().c_str());
 		unsigned int players = self->GetServerPlayers().first;
 		unsigned int playersMax = self->GetServerPlayers().second;
-		const map<string, string>& rules = self->GetServerRules();
+		const ServerEntry::Rules& rules = self->GetServerRules();
 
 		query.Write(name);
 		query.Write(_map);
 		query.Write(players);
 		query.Write(playersMax);
-		query.Write(rules.size());
+		query.Write(static_cast<unsigned int>(rules.size()));
 
 		for (const auto& i : rules)
 		{
-			RakString key(i.first.c_str());
-			RakString value(i.second.c_str());
+			RakString key(i.key->c_str());
+			RakString value(i.value->c_str());
 			query.Write(key);
 			query.Write(value);
 		}
 
-		query.Write(modfiles.size());
+		query.Write(static_cast<unsigned int>(modfiles.size()));
 
 		for (const auto& k : modfiles)
         {
@@ -330,6 +330,7 @@ void Dedicated::DedicatedThread()
 				}
 
 				Timer::GlobalTick();
+				Script::DispatchEvents();
 
 				this_thread::sleep_for(chrono::milliseconds(1));
 
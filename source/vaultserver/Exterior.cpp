@@ -1,28 +1,33 @@
 #include "Exterior.hpp"
-#include "sqlite/sqlite3.h"
+#include "Database.hpp"
 
-#include <algorithm>
+#include <cmath>
+#include <limits>
 
 using namespace std;
 using namespace DB;
 
 unordered_map<unsigned int, Exterior*> Exterior::cells;
-unordered_map<unsigned int, vector<Exterior*>> Exterior::worlds;
+unordered_map<unsigned int, unordered_map<unsigned long long, Exterior*>> Exterior::coords;
 
-Exterior::Exterior(const string& table, sqlite3_stmt* stmt)
+#ifdef VAULTMP_DEBUG
+DebugInput<Exterior> Exterior::debug;
+#endif
+
+Exterior::Exterior(const string& table, const DatabaseRow& row)
 {
-	if (sqlite3_column_count(stmt) != 5)
+	if (row.GetColumnCount() != 5)
 		throw VaultException("Malformed input database (exteriors): %s", table.c_str()).stacktrace();
 
-	unsigned int dlc = static_cast<unsigned int>(sqlite3_column_int(stmt, 4));
+	unsigned int dlc = static_cast<unsigned int>(row.GetInt(4));
 	// if DLC enabled
 
 	dlc <<= 24;
 
-	baseID = static_cast<unsigned int>(sqlite3_column_int(stmt, 0));
-	x = sqlite3_column_int(stmt, 1);
-	y = sqlite3_column_int(stmt, 2);
-	world = static_cast<unsigned int>(sqlite3_column_int(stmt, 3));
+	baseID = static_cast<unsigned int>(row.GetInt(0));
+	x = row.GetInt(1);
+	y = row.GetInt(2);
+	world = static_cast<unsigned int>(row.GetInt(3));
 
 	if (world & 0xFF000000)
 	{
@@ -37,12 +42,37 @@ Exterior::Exterior(const string& table, sqlite3_stmt* stmt)
 	}
 	else
 	{
-		cells.erase(baseID);
-		worlds[world].erase(remove_if(worlds[world].begin(), worlds[world].end(), [this](const Exterior* cell) { return cell->GetBase() == baseID; }), worlds[world].end());
+		auto it = cells.find(baseID);
+
+		if (it != cells.end())
+		{
+			auto& world_coords = coords[it->second->world];
+			auto it_coords = world_coords.find(Key(it->second->x, it->second->y));
+
+			if (it_coords != world_coords.end() && it_coords->second == it->second)
+			{
+				it->second->Link(0);
+				world_coords.erase(it_coords);
+			}
+
+			cells.erase(it);
+		}
 	}
 
+	adjacents.fill(0);
+	adjacents[0] = baseID;
+
 	cells.emplace(baseID, this);
-	worlds[world].emplace_back(this);
+
+	auto coord = coords[world].emplace(Key(x, y), this);
+
+	// worlds have their persistent cell at (0, 0) as well, coordinate lookups keep returning the cell read first
+	if (coord.second)
+		Link(baseID);
+#ifdef VAULTMP_DEBUG
+	else
+		debug.print("Cell ", hex, baseID, " at ", dec, x, ",", y, " in world ", hex, world, " is shadowed by cell ", coord.first->second->baseID);
+#endif
 
 	//All exteriors are also CELLs
 	//const Record& record = Record::Lookup(baseID, "CELL");
@@ -60,17 +90,61 @@ Expected<Exterior*> Exterior::Lookup(unsigned int baseID)
 
 Expected<Exterior*> Exterior::Lookup(unsigned int world, float X, float Y)
 {
-	signed int x = floor(X / SIZE);
-	signed int y = floor(Y / SIZE);
+	signed int x, y;
+	Exterior* cell;
 
-	auto it = find_if(worlds[world].begin(), worlds[world].end(), [&x, &y](const Exterior* cell) { return cell->x == x && cell->y == y; });
-
-	if (it != worlds[world].end())
-		return *it;
+	if (GetCoord(X, x) && GetCoord(Y, y) && (cell = Find(world, x, y)))
+		return cell;
 
 	return VaultException("No cell with coordinates (%f, %f) in world %08X found", X, Y, world);
 }
 
+bool Exterior::GetCoord(float value, signed int& coord)
+{
+	float _coord = floor(value / SIZE);
+
+	// this also rejects NaN, no cell lies outside of the signed int range
+	if (!(_coord >= static_cast<float>(numeric_limits<signed int>::min()) && _coord < -static_cast<float>(numeric_limits<signed int>::min())))
+		return false;
+
+	coord = static_cast<signed int>(_coord);
+	return true;
+}
+
+unsigned long long Exterior::Key(signed int x, signed int y)
+{
+	return (static_cast<unsigned long long>(static_cast<unsigned int>(x)) << 32) | static_cast<unsigned int>(y);
+}
+
+Exterior* Exterior::Find(unsigned int world, signed int x, signed int y)
+{
+	auto it = coords.find(world);
+
+	if (it == coords.end())
+		return nullptr;
+
+	auto it_coords = it->second.find(Key(x, y));
+
+	return it_coords != it->second.end() ? it_coords->second : nullptr;
+}
+
+void Exterior::Link(unsigned int base)
+{
+	// same order as GetAdjacents: self, then clockwise starting north
+	static constexpr signed int offsets[9][2] = {{0, 0}, {0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}};
+
+	for (unsigned int i = 1; i < 9; ++i)
+	{
+		Exterior* cell = Find(world, x + offsets[i][0], y + offsets[i][1]);
+
+		if (!cell)
+			continue;
+
+		adjacents[i] = cell->baseID;
+		cell->adjacents[((i + 3) % 8) + 1] = base;
+	}
+}
+
 unsigned int Exterior::GetBase() const
 {
 	return baseID;
@@ -91,23 +165,9 @@ signed int Exterior::GetY() const
 	return y;
 }
 
-array<unsigned int, 9> Exterior::GetAdjacents() const
+const array<unsigned int, 9>& Exterior::GetAdjacents() const
 {
-	float X = GetX() * SIZE;
-	float Y = GetY() * SIZE;
-
-	Expected<Exterior*> next_exterior;
-
-	return
-		{{GetBase(),
-		(next_exterior = DB::Exterior::Lookup(world, X, Y + SIZE)) ? next_exterior->GetBase() : 0u,
-		(next_exterior = DB::Exterior::Lookup(world, X + SIZE, Y + SIZE)) ? next_exterior->GetBase() : 0u,
-		(next_exterior = DB::Exterior::Lookup(world, X + SIZE, Y)) ? next_exterior->GetBase() : 0u,
-		(next_exterior = DB::Exterior::Lookup(world, X + SIZE, Y - SIZE)) ? next_exterior->GetBase() : 0u,
-		(next_exterior = DB::Exterior::Lookup(world, X, Y - SIZE)) ? next_exterior->GetBase() : 0u,
-		(next_exterior = DB::Exterior::Lookup(world, X - SIZE, Y - SIZE)) ? next_exterior->GetBase() : 0u,
-		(next_exterior = DB::Exterior::Lookup(world, X - SIZE, Y)) ? next_exterior->GetBase() : 0u,
-		(next_exterior = DB::Exterior::Lookup(world, X - SIZE, Y + SIZE)) ? next_exterior->GetBase() : 0u}};
+	return adjacents;
 }
 
 bool Exterior::IsValidCoordinate(float X, float Y) const
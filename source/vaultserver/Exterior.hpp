@@ -4,11 +4,14 @@
 #include "vaultserver.hpp"
 #include "Expected.hpp"
 
-#include <vector>
+#ifdef VAULTMP_DEBUG
+#include "Debug.hpp"
+#endif
+
 #include <array>
 #include <unordered_map>
 
-class sqlite3_stmt;
+class DatabaseRow;
 
 /**
  * \brief Represents a game exterior cell
@@ -20,12 +23,23 @@ namespace DB
 	{
 		private:
 			static std::unordered_map<unsigned int, Exterior*> cells;
-			static std::unordered_map<unsigned int, std::vector<Exterior*>> worlds;
+			static std::unordered_map<unsigned int, std::unordered_map<unsigned long long, Exterior*>> coords;
+
+#ifdef VAULTMP_DEBUG
+			static DebugInput<Exterior> debug;
+#endif
+
+			static bool GetCoord(float value, signed int& coord);
+			static unsigned long long Key(signed int x, signed int y);
+			static Exterior* Find(unsigned int world, signed int x, signed int y);
 
 			unsigned int baseID;
 			unsigned int world;
 			signed int x;
 			signed int y;
+			std::array<unsigned int, 9> adjacents;
+
+			void Link(unsigned int base);
 
 			Exterior(const Exterior&) = delete;
 			Exterior& operator=(const Exterior&) = delete;
@@ -40,10 +54,10 @@ namespace DB
 			unsigned int GetWorld() const;
 			signed int GetX() const;
 			signed int GetY() const;
-			std::array<unsigned int, 9> GetAdjacents() const;
+			const std::array<unsigned int, 9>& GetAdjacents() const;
 			bool IsValidCoordinate(float X, float Y) const;
 
-			Exterior(const std::string& table, sqlite3_stmt* stmt);
+			Exterior(const std::string& table, const DatabaseRow& row);
 			~Exterior() = default;
 			// must never be called. only defined because vector requires it
 			Exterior(Exterior&&) { std::terminate(); }
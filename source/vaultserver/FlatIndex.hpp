@@ -0,0 +1,109 @@
+#ifndef FLATINDEX_H
+#define FLATINDEX_H
+
+#include <vector>
+#include <climits>
+
+/**
+ * \brief An open addressing hash table keyed by baseID, stored in a single contiguous array
+ *
+ * Entries are never removed. Linear probing keeps colliding keys on neighbouring cache lines.
+ */
+
+template<typename T>
+class FlatIndex
+{
+	private:
+		// FFFFFFFF is never a valid form ID
+		static constexpr unsigned int EMPTY = UINT_MAX;
+
+		struct Slot
+		{
+			unsigned int key;
+			T value;
+		};
+
+		std::vector<Slot> slots;
+		std::size_t count;
+		unsigned int shift;
+
+		std::size_t Probe(unsigned int key) const
+		{
+			std::size_t mask = slots.size() - 1;
+			std::size_t i = static_cast<unsigned int>(key * 2654435761u) >> shift;
+
+			while (slots[i].key != key && slots[i].key != EMPTY)
+				i = (i + 1) & mask;
+
+			return i;
+		}
+
+		Slot& Reserve(unsigned int key)
+		{
+			if ((count + 1) * 2 > slots.size())
+			{
+				std::vector<Slot> old(slots.empty() ? 16 : slots.size() * 2, Slot{EMPTY, T()});
+				old.swap(slots);
+				shift = slots.size() == 16 ? 28 : shift - 1;
+
+				for (const auto& slot : old)
+					if (slot.key != EMPTY)
+						slots[Probe(slot.key)] = slot;
+			}
+
+			return slots[Probe(key)];
+		}
+
+	public:
+		FlatIndex() : count(0), shift(32) {}
+
+		/**
+		 * \brief Adds a value, an existing value for the key is kept
+		 */
+		void Insert(unsigned int key, const T& value)
+		{
+			Slot& slot = Reserve(key);
+
+			if (slot.key == EMPTY)
+			{
+				slot = {key, value};
+				++count;
+			}
+		}
+
+		/**
+		 * \brief Adds a value, an existing value for the key is replaced
+		 */
+		void Assign(unsigned int key, const T& value)
+		{
+			Slot& slot = Reserve(key);
+
+			if (slot.key == EMPTY)
+				++count;
+
+			slot = {key, value};
+		}
+
+		/**
+		 * \brief Returns the value of a key, or nullptr if there is none
+		 */
+		const T* Find(unsigned int key) const
+		{
+			if (slots.empty() || key == EMPTY)
+				return nullptr;
+
+			const Slot& slot = slots[Probe(key)];
+			return slot.key == key ? &slot.value : nullptr;
+		}
+
+		void Clear()
+		{
+			slots.clear();
+			count = 0;
+			shift = 32;
+		}
+
+		std::size_t size() const { return count; }
+};
+
+#endif
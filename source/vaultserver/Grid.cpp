@@ -0,0 +1,166 @@
+#include "Grid.hpp"
+#include "Exterior.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace RakNet;
+
+constexpr float Grid::SIZE;
+constexpr signed int Grid::LIMIT;
+Guarded<> Grid::cs;
+unordered_map<unsigned int, unordered_map<unsigned long long, vector<NetworkID>>> Grid::buckets;
+unordered_map<unsigned int, vector<NetworkID>> Grid::cells;
+unordered_map<NetworkID, Grid::Entry> Grid::entries;
+
+unsigned int Grid::GetSpace(unsigned int cell) noexcept
+{
+	auto exterior = DB::Exterior::Lookup(cell);
+	return exterior ? exterior->GetWorld() : cell;
+}
+
+signed int Grid::GetCoord(float value) noexcept
+{
+	float coord = floor(value / SIZE);
+
+	// NaN goes to the origin, infinite or far out positions to the outermost buckets
+	if (isnan(coord))
+		return 0;
+
+	return static_cast<signed int>(max(static_cast<float>(-LIMIT), min(coord, static_cast<float>(LIMIT))));
+}
+
+unsigned long long Grid::GetBucket(signed int x, signed int y) noexcept
+{
+	return (static_cast<unsigned long long>(static_cast<unsigned int>(x)) << 32) | static_cast<unsigned int>(y);
+}
+
+void Grid::Unlink(NetworkID id, const Entry& entry) noexcept
+{
+	auto erase = [id](vector<NetworkID>& ids) {
+		auto it = find(ids.begin(), ids.end(), id);
+
+		if (it != ids.end())
+		{
+			*it = ids.back();
+			ids.pop_back();
+		}
+
+		return ids.empty();
+	};
+
+	auto& space = buckets[entry.space];
+
+	if (erase(space[entry.bucket]))
+		space.erase(entry.bucket);
+
+	if (space.empty())
+		buckets.erase(entry.space);
+
+	if (erase(cells[entry.cell]))
+		cells.erase(entry.cell);
+}
+
+void Grid::Update(NetworkID id, unsigned int cell, const tuple<float, float, float>& pos) noexcept
+{
+	if (!cell)
+	{
+		Remove(id);
+		return;
+	}
+
+	signed int x = GetCoord(get<0>(pos));
+	signed int y = GetCoord(get<1>(pos));
+
+	cs.Operate([id, cell, x, y, &pos]() {
+		auto it = entries.find(id);
+		bool found = it != entries.end();
+
+		// the space only changes along with the cell, avoid the exterior lookup on movement
+		unsigned int space = found && it->second.cell == cell ? it->second.space : GetSpace(cell);
+		unsigned long long bucket = GetBucket(x, y);
+
+		if (!found || it->second.bucket != bucket || it->second.cell != cell)
+		{
+			if (found)
+				Unlink(id, it->second);
+
+			buckets[space][bucket].emplace_back(id);
+			cells[cell].emplace_back(id);
+		}
+
+		entries[id] = Entry{cell, space, bucket, get<0>(pos), get<1>(pos), get<2>(pos)};
+	});
+}
+
+void Grid::Remove(NetworkID id) noexcept
+{
+	cs.Operate([id]() {
+		auto it = entries.find(id);
+
+		if (it == entries.end())
+			return;
+
+		Unlink(id, it->second);
+		entries.erase(it);
+	});
+}
+
+vector<NetworkID> Grid::GetInRadius(unsigned int cell, float X, float Y, float Z, float R) noexcept
+{
+	// this also rejects a NaN radius
+	if (!(R >= 0.0f))
+		return vector<NetworkID>();
+
+	unsigned int space = GetSpace(cell);
+	signed int x1 = GetCoord(X - R), x2 = GetCoord(X + R);
+	signed int y1 = GetCoord(Y - R), y2 = GetCoord(Y + R);
+
+	return cs.Operate([space, x1, x2, y1, y2, X, Y, Z, R]() {
+		vector<NetworkID> result;
+		auto grid = buckets.find(space);
+
+		if (grid == buckets.end())
+			return result;
+
+		auto test = [&result, X, Y, Z, R](NetworkID id, const Entry& entry) {
+			float dX = entry.X - X, dY = entry.Y - Y, dZ = entry.Z - Z;
+
+			if (dX * dX + dY * dY + dZ * dZ <= R * R)
+				result.emplace_back(id);
+		};
+
+		// a radius spanning more buckets than exist is cheaper to answer by a scan of the buckets of the space
+		if (static_cast<unsigned long long>(static_cast<signed long long>(x2) - x1 + 1) * (static_cast<signed long long>(y2) - y1 + 1) > grid->second.size())
+		{
+			for (const auto& bucket : grid->second)
+				for (NetworkID id : bucket.second)
+					test(id, entries.find(id)->second);
+
+			return result;
+		}
+
+		for (signed int x = x1; x <= x2; ++x)
+			for (signed int y = y1; y <= y2; ++y)
+			{
+				auto it = grid->second.find(GetBucket(x, y));
+
+				if (it == grid->second.end())
+					continue;
+
+				for (NetworkID id : it->second)
+					test(id, entries.find(id)->second);
+			}
+
+		return result;
+	});
+}
+
+vector<NetworkID> Grid::GetInCell(unsigned int cell) noexcept
+{
+	return cs.Operate([cell]() {
+		auto it = cells.find(cell);
+		return it != cells.end() ? it->second : vector<NetworkID>();
+	});
+}
@@ -0,0 +1,65 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include "vaultserver.hpp"
+#include "Guarded.hpp"
+#include "RakNet.hpp"
+
+#include <vector>
+#include <tuple>
+#include <unordered_map>
+
+/**
+ * \brief Uniform grid over the network positions of all Objects
+ *
+ * The exterior cells of a worldspace share one grid so that radius queries can cross cell borders, every interior has its own grid
+ */
+
+class Grid
+{
+	private:
+		struct Entry
+		{
+			unsigned int cell;
+			unsigned int space;
+			unsigned long long bucket;
+			float X, Y, Z;
+		};
+
+		// bucket coordinates are clamped to this, so that the number of buckets of a query fits in an unsigned long long
+		static constexpr signed int LIMIT = 1 << 30;
+
+		static Guarded<> cs;
+		static std::unordered_map<unsigned int, std::unordered_map<unsigned long long, std::vector<RakNet::NetworkID>>> buckets;
+		static std::unordered_map<unsigned int, std::vector<RakNet::NetworkID>> cells;
+		static std::unordered_map<RakNet::NetworkID, Entry> entries;
+
+		static unsigned int GetSpace(unsigned int cell) noexcept;
+		static signed int GetCoord(float value) noexcept;
+		static unsigned long long GetBucket(signed int x, signed int y) noexcept;
+		static void Unlink(RakNet::NetworkID id, const Entry& entry) noexcept;
+
+		Grid() = delete;
+
+	public:
+		static constexpr float SIZE = 1024.0f;
+
+		/**
+		 * \brief Moves an Object to its current network cell and position, a cell of zero removes it
+		 */
+		static void Update(RakNet::NetworkID id, unsigned int cell, const std::tuple<float, float, float>& pos) noexcept;
+		/**
+		 * \brief Removes an Object from the grid
+		 */
+		static void Remove(RakNet::NetworkID id) noexcept;
+		/**
+		 * \brief Returns the Objects within radius R of a point in the space of the given cell
+		 */
+		static std::vector<RakNet::NetworkID> GetInRadius(unsigned int cell, float X, float Y, float Z, float R) noexcept;
+		/**
+		 * \brief Returns the Objects in a given cell
+		 */
+		static std::vector<RakNet::NetworkID> GetInCell(unsigned int cell) noexcept;
+};
+
+#endif
@@ -1,28 +1,28 @@
 #include "Interior.hpp"
-#include "sqlite/sqlite3.h"
+#include "Database.hpp"
 
 using namespace std;
 using namespace DB;
 
 unordered_map<unsigned int, Interior*> Interior::cells;
 
-Interior::Interior(const string& table, sqlite3_stmt* stmt)
+Interior::Interior(const string& table, const DatabaseRow& row)
 {
-	if (sqlite3_column_count(stmt) != 8)
+	if (row.GetColumnCount() != 8)
 		throw VaultException("Malformed input database (interiors): %s", table.c_str()).stacktrace();
 
-	unsigned int dlc = static_cast<unsigned int>(sqlite3_column_int(stmt, 7));
+	unsigned int dlc = static_cast<unsigned int>(row.GetInt(7));
 	// if DLC enabled
 
 	dlc <<= 24;
 
-	baseID = static_cast<unsigned int>(sqlite3_column_int(stmt, 0));
-	x1 = sqlite3_column_double(stmt, 1);
-	y1 = sqlite3_column_double(stmt, 2);
-	z1 = sqlite3_column_double(stmt, 3);
-	x2 = sqlite3_column_double(stmt, 4);
-	y2 = sqlite3_column_double(stmt, 5);
-	z2 = sqlite3_column_double(stmt, 6);
+	baseID = static_cast<unsigned int>(row.GetInt(0));
+	x1 = row.GetDouble(1);
+	y1 = row.GetDouble(2);
+	z1 = row.GetDouble(3);
+	x2 = row.GetDouble(4);
+	y2 = row.GetDouble(5);
+	z2 = row.GetDouble(6);
 
 	if (baseID & 0xFF000000)
 	{
@@ -7,7 +7,7 @@
 #include <unordered_map>
 #include <array>
 
-class sqlite3_stmt;
+class DatabaseRow;
 
 /**
  * \brief Represents a game interior cell
@@ -34,7 +34,7 @@ namespace DB
 			std::array<float, 6> GetBounds() const;
 			bool IsValidCoordinate(float X, float Y, float Z) const;
 
-			Interior(const std::string& table, sqlite3_stmt* stmt);
+			Interior(const std::string& table, const DatabaseRow& row);
 			~Interior() = default;
 			// must never be called. only defined because vector requires it
 			Interior(Interior&&) { std::terminate(); }
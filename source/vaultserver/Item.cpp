@@ -1,44 +1,43 @@
 #include "Item.hpp"
-#include "sqlite/sqlite3.h"
+#include "Database.hpp"
 
 using namespace std;
 using namespace DB;
 
-unordered_map<unsigned int, Item*> Item::items;
+FlatIndex<Item*> Item::items;
 
-Item::Item(const string& table, sqlite3_stmt* stmt)
+Item::Item(const string& table, const DatabaseRow& row)
 {
-	if (sqlite3_column_count(stmt) != 6)
+	if (row.GetColumnCount() != 6)
 		throw VaultException("Malformed input database (items): %s", table.c_str()).stacktrace();
 
-	unsigned int dlc = static_cast<unsigned int>(sqlite3_column_int(stmt, 5));
+	unsigned int dlc = static_cast<unsigned int>(row.GetInt(5));
 	// if DLC enabled
 
 	dlc <<= 24;
 
-	baseID = static_cast<unsigned int>(sqlite3_column_int(stmt, 0));
-	value = sqlite3_column_int(stmt, 1);
-	health = sqlite3_column_int(stmt, 2);
-	weight = sqlite3_column_double(stmt, 3);
-	slot = sqlite3_column_int(stmt, 4);
+	baseID = static_cast<unsigned int>(row.GetInt(0));
+	value = row.GetInt(1);
+	health = row.GetInt(2);
+	weight = row.GetDouble(3);
+	slot = row.GetInt(4);
 
 	if (baseID & 0xFF000000)
 	{
 		baseID &= 0x00FFFFFF;
 		baseID |= dlc;
+		items.Insert(baseID, this);
 	}
 	else
-		items.erase(baseID);
-
-	items.emplace(baseID, this);
+		items.Assign(baseID, this);
 }
 
 Expected<Item*> Item::Lookup(unsigned int baseID)
 {
-	auto it = items.find(baseID);
+	auto item = items.Find(baseID);
 
-	if (it != items.end())
-		return it->second;
+	if (item)
+		return *item;
 
 	return VaultException("No item with baseID %08X found", baseID);
 }
@@ -3,10 +3,9 @@
 
 #include "vaultserver.hpp"
 #include "Expected.hpp"
+#include "FlatIndex.hpp"
 
-#include <unordered_map>
-
-class sqlite3_stmt;
+class DatabaseRow;
 
 /**
  * \brief Represents an item
@@ -17,7 +16,7 @@ namespace DB
 	class Item
 	{
 		private:
-			static std::unordered_map<unsigned int, Item*> items;
+			static FlatIndex<Item*> items;
 
 			unsigned int baseID;
 			unsigned int value;
@@ -37,7 +36,7 @@ namespace DB
 			float GetWeight() const;
 			unsigned int GetSlot() const;
 
-			Item(const std::string& table, sqlite3_stmt* stmt);
+			Item(const std::string& table, const DatabaseRow& row);
 			~Item() = default;
 			// must never be called. only defined because vector requires it
 			Item(Item&&) { std::terminate(); }
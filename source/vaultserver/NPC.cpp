@@ -1,6 +1,6 @@
 #include "NPC.hpp"
 #include "Race.hpp"
-#include "sqlite/sqlite3.h"
+#include "Database.hpp"
 
 #include <algorithm>
 
@@ -8,24 +8,27 @@ using namespace std;
 using namespace DB;
 
 unordered_map<unsigned int, NPC*> NPC::npcs;
+array<vector<NPC*>, 16> NPC::attributes;
+bool NPC::indexed = false;
+Guarded<> NPC::cs;
 
-NPC::NPC(const string& table, sqlite3_stmt* stmt) : new_female(-1), new_race(0x00000000)
+NPC::NPC(const string& table, const DatabaseRow& row) : claims(0), new_female(-1), new_race(0x00000000), base(this), traits(this), inventory(this)
 {
-	if (sqlite3_column_count(stmt) != 8)
+	if (row.GetColumnCount() != 8)
 		throw VaultException("Malformed input database (NPCs): %s", table.c_str()).stacktrace();
 
-	unsigned int dlc = static_cast<unsigned int>(sqlite3_column_int(stmt, 7));
+	unsigned int dlc = static_cast<unsigned int>(row.GetInt(7));
 	// if DLC enabled
 
 	dlc <<= 24;
 
-	baseID = static_cast<unsigned int>(sqlite3_column_int(stmt, 0));
-	essential = static_cast<bool>(sqlite3_column_int(stmt, 1));
-	female = static_cast<bool>(sqlite3_column_int(stmt, 2));
-	race = static_cast<unsigned int>(sqlite3_column_int(stmt, 3));
-	template_ = static_cast<unsigned int>(sqlite3_column_int(stmt, 4));
-	flags = static_cast<unsigned short>(sqlite3_column_int(stmt, 5));
-	deathitem = static_cast<unsigned int>(sqlite3_column_int(stmt, 6));
+	baseID = static_cast<unsigned int>(row.GetInt(0));
+	essential = static_cast<bool>(row.GetInt(1));
+	female = static_cast<bool>(row.GetInt(2));
+	race = static_cast<unsigned int>(row.GetInt(3));
+	template_ = static_cast<unsigned int>(row.GetInt(4));
+	flags = static_cast<unsigned short>(row.GetInt(5));
+	deathitem = static_cast<unsigned int>(row.GetInt(6));
 
 	if (race & 0xFF000000)
 	{
@@ -66,84 +69,120 @@ Expected<NPC*> NPC::Lookup(unsigned int baseID)
 	return VaultException("No NPC with baseID %08X found", baseID);
 }
 
-Expected<NPC*> NPC::GetNPC(const function<bool(const NPC&)>& pred)
+Expected<NPC*> NPC::GetNPC(unsigned int with, unsigned int without)
 {
-	auto it = find_if(npcs.begin(), npcs.end(), [&pred](const pair<const unsigned int, const NPC*>& npcs) { return pred(*npcs.second); });
+	NPC* result = cs.Operate([with, without]() -> NPC* {
+		if (!indexed)
+			Index();
 
-	if (it != npcs.end())
-		return it->second;
+		for (unsigned int i = 0; i < attributes.size(); ++i)
+			if ((i & with) == with && !(i & without))
+				for (NPC* npc : attributes[i])
+					if (!npc->claims)
+						return npc;
+
+		return nullptr;
+	});
+
+	if (result)
+		return result;
 
-	return VaultException("No NPC found fulfilling the conditions of the given function");
+	return VaultException("No unused NPC found with attributes %08X and without %08X", with, without);
 }
 
-unsigned int NPC::GetBase() const
+void NPC::Claim(unsigned int baseID)
 {
-	return baseID;
+	cs.Operate([baseID]() {
+		auto it = npcs.find(baseID);
+
+		if (it != npcs.end())
+			++it->second->claims;
+	});
 }
 
-bool NPC::IsEssential() const
+void NPC::Release(unsigned int baseID)
 {
-	if (template_ && (flags & TplFlags::Base))
-	{
-		auto npc = Lookup(template_);
+	cs.Operate([baseID]() {
+		auto it = npcs.find(baseID);
 
-		if (npc)
-			return npc->IsEssential();
-	}
+		if (it != npcs.end() && it->second->claims)
+			--it->second->claims;
+	});
+}
 
-	return essential;
+void NPC::ResolveTemplates()
+{
+	for (const auto& npc : npcs)
+	{
+		npc.second->base = npc.second->Resolve(TplFlags::Base);
+		npc.second->traits = npc.second->Resolve(TplFlags::Traits);
+		npc.second->inventory = npc.second->Resolve(TplFlags::Inventory);
+	}
 }
 
-bool NPC::IsFemale() const
+NPC* NPC::Resolve(unsigned short flag)
 {
-	if (template_ && (flags & TplFlags::Traits))
+	vector<const NPC*> chain{this};
+	NPC* npc = this;
+
+	while (npc->template_ && (npc->flags & flag))
 	{
-		auto npc = Lookup(template_);
+		auto it = npcs.find(npc->template_);
 
-		if (npc)
-			return npc->IsFemale();
+		// the template may be a leveled character, which has no entry here
+		if (it == npcs.end())
+			break;
+
+		if (find(chain.begin(), chain.end(), it->second) != chain.end())
+			throw VaultException("Template cycle at NPC %08X", npc->baseID).stacktrace();
+
+		npc = it->second;
+		chain.emplace_back(npc);
 	}
 
-	return ((new_female != -1) ? new_female : female);
+	return npc;
 }
 
-bool NPC::IsOriginalFemale() const
+void NPC::Index()
 {
-	if (template_ && (flags & TplFlags::Traits))
-	{
-		auto npc = Lookup(template_);
+	// attributes follow templates and races, so they can only be computed once every database is loaded
+	for (auto& bucket : attributes)
+		bucket.clear();
 
-		if (npc)
-			return npc->IsOriginalFemale();
-	}
+	for (const auto& npc : npcs)
+		attributes[npc.second->GetAttributes()].emplace_back(npc.second);
 
-	return female;
+	indexed = true;
 }
 
-unsigned int NPC::GetRace() const
+unsigned int NPC::GetBase() const
 {
-	if (template_ && (flags & TplFlags::Traits))
-	{
-		auto npc = Lookup(template_);
+	return baseID;
+}
 
-		if (npc)
-			return npc->GetRace();
-	}
+bool NPC::IsEssential() const
+{
+	return base->essential;
+}
 
-	return (new_race ? new_race : race);
+bool NPC::IsFemale() const
+{
+	return ((traits->new_female != -1) ? traits->new_female : traits->female);
 }
 
-unsigned int NPC::GetOriginalRace() const
+bool NPC::IsOriginalFemale() const
 {
-	if (template_ && (flags & TplFlags::Traits))
-	{
-		auto npc = Lookup(template_);
+	return traits->female;
+}
 
-		if (npc)
-			return npc->GetOriginalRace();
-	}
+unsigned int NPC::GetRace() const
+{
+	return (traits->new_race ? traits->new_race : traits->race);
+}
 
-	return race;
+unsigned int NPC::GetOriginalRace() const
+{
+	return traits->race;
 }
 
 unsigned int NPC::GetTemplate() const
@@ -158,53 +197,46 @@ unsigned short NPC::GetFlags() const
 
 unsigned int NPC::GetDeathItem() const
 {
-	if (template_ && (flags & TplFlags::Traits))
-	{
-		auto npc = Lookup(template_);
-
-		if (npc)
-			return npc->GetDeathItem();
-	}
-
-	return deathitem;
+	return traits->deathitem;
 }
 
-const vector<BaseContainer*>& NPC::GetBaseContainer() const
+unsigned int NPC::GetAttributes() const
 {
-	if (template_ && (flags & TplFlags::Inventory))
-	{
-		auto npc = Lookup(template_);
+	unsigned int result = 0x00000000;
 
-		if (npc)
-			return npc->GetBaseContainer();
-	}
+	if (IsEssential())
+		result |= Essential;
 
-	return BaseContainer::Lookup(baseID);
+	if (IsFemale())
+		result |= Female;
+
+	auto race = Race::Lookup(GetRace());
+
+	if (race && race->IsChild())
+		result |= Child;
+
+	if (baseID & 0xFF000000)
+		result |= DLC;
+
+	return result;
+}
+
+BaseContainer::Span NPC::GetBaseContainer() const
+{
+	return BaseContainer::Lookup(inventory->baseID);
 }
 
 void NPC::SetRace(unsigned int race)
 {
-	if (template_ && (flags & TplFlags::Traits))
+	if (Race::Lookup(race))
 	{
-		auto npc = Lookup(template_);
-
-		if (npc)
-			return npc->SetRace(race);
+		traits->new_race = race;
+		cs.Operate([]() { indexed = false; });
 	}
-
-	if (Race::Lookup(race))
-		this->new_race = race;
 }
 
 void NPC::SetFemale(bool female)
 {
-	if (template_ && (flags & TplFlags::Traits))
-	{
-		auto npc = Lookup(template_);
-
-		if (npc)
-			return npc->SetFemale(female);
-	}
-
-	this->new_female = female;
+	traits->new_female = female;
+	cs.Operate([]() { indexed = false; });
 }
@@ -4,13 +4,14 @@
 #include "vaultserver.hpp"
 #include "Expected.hpp"
 #include "BaseContainer.hpp"
+#include "Guarded.hpp"
 
+#include <array>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
-#include <functional>
 
-class sqlite3_stmt;
+class DatabaseRow;
 
 /**
  * \brief Represents a NPC
@@ -36,6 +37,13 @@ namespace DB
 			};
 
 			static std::unordered_map<unsigned int, NPC*> npcs;
+			static std::array<std::vector<NPC*>, 16> attributes;
+			static bool indexed;
+			static Guarded<> cs;
+
+			static void Index();
+
+			NPC* Resolve(unsigned short flag);
 
 			unsigned int baseID;
 			bool essential;
@@ -44,16 +52,46 @@ namespace DB
 			unsigned int template_;
 			unsigned short flags;
 			unsigned int deathitem;
+			// number of players using this NPC as their base
+			unsigned int claims;
 
 			signed int new_female;
 			unsigned int new_race;
 
+			// the NPCs the fields of each template flag are actually taken from
+			NPC* base;
+			NPC* traits;
+			NPC* inventory;
+
 			NPC(const NPC&) = delete;
 			NPC& operator=(const NPC&) = delete;
 
 		public:
+			enum Attributes : unsigned int
+			{
+				Essential = 0x01,
+				Female    = 0x02,
+				Child     = 0x04,
+				DLC       = 0x08,
+			};
+
 			static Expected<NPC*> Lookup(unsigned int baseID);
-			static Expected<NPC*> GetNPC(const std::function<bool(const NPC&)>& pred);
+			/**
+			 * \brief Resolves the template chains of all NPCs, must be called once after loading
+			 */
+			static void ResolveTemplates();
+			/**
+			 * \brief Returns the first NPC which has all attributes of with, none of without and is not the base of a player
+			 */
+			static Expected<NPC*> GetNPC(unsigned int with, unsigned int without);
+			/**
+			 * \brief Counts a player using the given base, bases which are no NPC are ignored
+			 */
+			static void Claim(unsigned int baseID);
+			/**
+			 * \brief Reverts a Claim
+			 */
+			static void Release(unsigned int baseID);
 
 			unsigned int GetBase() const;
 			bool IsEssential() const;
@@ -64,12 +102,13 @@ namespace DB
 			unsigned int GetTemplate() const;
 			unsigned short GetFlags() const;
 			unsigned int GetDeathItem() const;
-			const std::vector<BaseContainer*>& GetBaseContainer() const;
+			unsigned int GetAttributes() const;
+			BaseContainer::Span GetBaseContainer() const;
 
 			void SetRace(unsigned int race);
 			void SetFemale(bool female);
 
-			NPC(const std::string& table, sqlite3_stmt* stmt);
+			NPC(const std::string& table, const DatabaseRow& row);
 			~NPC() = default;
 			// must never be called. only defined because vector requires it
 			NPC(NPC&&) { std::terminate(); }
@@ -4,6 +4,11 @@
 #include "amx/amx.h"
 #include "amx/amxaux.h"
 
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
 using namespace std;
 using namespace RakNet;
 
@@ -16,12 +21,87 @@ extern "C" {
 	int AMXAPI amx_FileInit(AMX*);
 }
 
-static vector<vector<char>> strings;
+/**
+ * \brief Bump allocator for strings extracted from native arguments
+ *
+ * Blocks are kept across resets, so after warm-up extracting a string does not allocate.
+ */
+class StringArena
+{
+	private:
+		static constexpr size_t BLOCK_SIZE = 4096;
+
+		vector<vector<char>> blocks;
+		size_t block = 0;
+		size_t used = 0;
+
+	public:
+		char* allocate(size_t size) noexcept
+		{
+			while (block < blocks.size() && used + size > blocks[block].size())
+			{
+				++block;
+				used = 0;
+			}
+
+			if (block == blocks.size())
+			{
+				size_t length = size > BLOCK_SIZE ? size : BLOCK_SIZE;
+				blocks.emplace_back(length);
+				used = 0;
+			}
+
+			char* value = &blocks[block][used];
+			used += size;
+			return value;
+		}
+
+		void reset() noexcept
+		{
+			block = 0;
+			used = 0;
+		}
+};
+
+/**
+ * \brief A public resolved for a given signature
+ */
+struct CallStub
+{
+	string name;
+	string argl;
+	int index;
+	unsigned int strings;
+};
+
+static StringArena strings;
 static vector<pair<cell*, double>> floats;
-static pair<cell*, NetworkID*> data = {nullptr, nullptr};
+static pair<cell*, vector<NetworkID>> data;
+// keyed by the hashes of name and signature, so a public called with different signatures keeps a stub for each
+static unordered_map<AMX*, unordered_map<unsigned long long, CallStub>> stubs;
+
+/**
+ * \brief Returns the number of cells from addr to the end of the data and heap or the stack of an AMX, 0 if addr points elsewhere
+ */
+static cell PAWN_extent(AMX* amx, const cell* addr) noexcept {
+	const AMX_HEADER* hdr = reinterpret_cast<const AMX_HEADER*>(amx->base);
+	uintptr_t data = reinterpret_cast<uintptr_t>(amx->data ? amx->data : amx->base + hdr->dat);
+	uintptr_t offset = reinterpret_cast<uintptr_t>(addr) - data;
+
+	if (reinterpret_cast<uintptr_t>(addr) < data || offset % sizeof(cell))
+		return 0;
+
+	if (offset < static_cast<uintptr_t>(amx->hea))
+		return (amx->hea - offset) / sizeof(cell);
+
+	if (offset >= static_cast<uintptr_t>(amx->stk) && offset < static_cast<uintptr_t>(amx->stp))
+		return (amx->stp - offset) / sizeof(cell);
+
+	return 0;
+}
 
 void free_strings() noexcept {
-	strings.clear();
+	strings.reset();
 }
 
 void free_floats() noexcept {
@@ -32,12 +112,11 @@ void free_floats() noexcept {
 }
 
 void free_data(unsigned int size) noexcept {
-	if (data.first && data.second)
-		for (unsigned int i = 0; i < size; ++i)
+	if (data.first)
+		for (unsigned int i = 0; i < size && i < data.second.size(); ++i)
 			data.first[i] = data.second[i];
 
 	data.first = nullptr;
-	data.second = nullptr;
 }
 
 void after_call() noexcept {
@@ -81,8 +160,7 @@ struct PAWN_extract_<const char*, I, F> {
 		source = amx_Address(amx, params[I]);
 		amx_StrLen(source, &len);
 
-		strings.emplace_back(len + 1);
-		char* value = &strings.back()[0];
+		char* value = strings.allocate(len + 1);
 		amx_GetString(value, source, 0, UNLIMITED);
 
 		return value;
@@ -98,12 +176,15 @@ struct PAWN_extract_<double*, I, F> {
 };
 
 template<unsigned int I, unsigned int F>
-struct PAWN_extract_<NetworkID**, I, F> {
-	inline static NetworkID** PAWN_extract(AMX*&& amx, const cell*&& params) noexcept {
+struct PAWN_extract_<NetworkID*, I, F> {
+	inline static NetworkID* PAWN_extract(AMX*&& amx, const cell*&& params) noexcept {
 		constexpr ScriptFunctionData const& F_ = Script::functions[F];
-		static_assert(F_.func.numargs == I, "NetworkID** must be the last parameter");
+		static_assert(F_.func.numargs == I + 1 && F_.func.types[I] == 'i', "NetworkID* must be followed by its size as the last parameter");
 		data.first = amx_Address(amx, params[I]);
-		return &data.second;
+		// never write past the array the script passed, whatever size it claims
+		cell size = min(params[I + 1], PAWN_extent(amx, data.first));
+		data.second.resize(size > 0 ? size : 0);
+		return data.second.data();
 	}
 };
 
@@ -169,6 +250,9 @@ template<> struct F_<1> { static constexpr AMX_NATIVE_INFO F{"CreateTimer", PAWN
 template<> struct F_<2> { static constexpr AMX_NATIVE_INFO F{"CreateTimerEx", PAWN::CreateTimerEx}; };
 template<> struct F_<4> { static constexpr AMX_NATIVE_INFO F{"MakePublic", PAWN::MakePublic}; };
 template<> struct F_<5> { static constexpr AMX_NATIVE_INFO F{"CallPublic", PAWN::CallPublic}; };
+template<> struct F_<Script::FI("GetPosBatch")> { static constexpr AMX_NATIVE_INFO F{"GetPosBatch", PAWN::GetPosBatch}; };
+template<> struct F_<Script::FI("GetCellBatch")> { static constexpr AMX_NATIVE_INFO F{"GetCellBatch", PAWN::GetCellBatch}; };
+template<> struct F_<Script::FI("GetActorValueBatch")> { static constexpr AMX_NATIVE_INFO F{"GetActorValueBatch", PAWN::GetActorValueBatch}; };
 
 template<size_t... Indices>
 inline AMX_NATIVE_INFO* PAWN::functions(indices<Indices...>) {
@@ -395,6 +479,57 @@ cell PAWN::CallPublic(AMX* amx, const cell* params) noexcept
 	return Script::CallPublicPAWN(&name[0], args);
 }
 
+// cells are 64 bit wide, ID and Float arrays are passed to the server in place
+static_assert(sizeof(cell) == sizeof(NetworkID) && sizeof(cell) == sizeof(double), "cell must be able to hold a NetworkID and a double");
+
+cell PAWN::GetPosBatch(AMX* amx, const cell* params) noexcept
+{
+	if (params[2] <= 0)
+		return 0;
+
+	cell* ids = amx_Address(amx, params[1]);
+	cell* X = amx_Address(amx, params[3]);
+	cell* Y = amx_Address(amx, params[4]);
+	cell* Z = amx_Address(amx, params[5]);
+
+	if (PAWN_extent(amx, ids) < params[2] || PAWN_extent(amx, X) < params[2] || PAWN_extent(amx, Y) < params[2] || PAWN_extent(amx, Z) < params[2])
+		return 0;
+
+	return Script::GetPosBatch(reinterpret_cast<const NetworkID*>(ids), params[2], reinterpret_cast<double*>(X), reinterpret_cast<double*>(Y), reinterpret_cast<double*>(Z));
+}
+
+cell PAWN::GetCellBatch(AMX* amx, const cell* params) noexcept
+{
+	if (params[2] <= 0)
+		return 0;
+
+	cell* ids = amx_Address(amx, params[1]);
+	cell* dest = amx_Address(amx, params[3]);
+
+	if (PAWN_extent(amx, ids) < params[2] || PAWN_extent(amx, dest) < params[2])
+		return 0;
+
+	vector<unsigned int> cells(params[2]);
+	unsigned int found = Script::GetCellBatch(reinterpret_cast<const NetworkID*>(ids), cells.size(), cells.data());
+	copy(cells.begin(), cells.end(), dest);
+
+	return found;
+}
+
+cell PAWN::GetActorValueBatch(AMX* amx, const cell* params) noexcept
+{
+	if (params[2] <= 0)
+		return 0;
+
+	cell* ids = amx_Address(amx, params[1]);
+	cell* values = amx_Address(amx, params[4]);
+
+	if (PAWN_extent(amx, ids) < params[2] || PAWN_extent(amx, values) < params[2])
+		return 0;
+
+	return Script::GetActorValueBatch(reinterpret_cast<const NetworkID*>(ids), params[2], params[3], reinterpret_cast<double*>(values));
+}
+
 int PAWN::LoadProgram(AMX* amx, const char* filename, void* memblock)
 {
 	return aux_LoadProgram(amx, filename, memblock);
@@ -402,6 +537,10 @@ int PAWN::LoadProgram(AMX* amx, const char* filename, void* memblock)
 
 int PAWN::Init(AMX* amx)
 {
+	// amx_Register stores native addresses in 32 bits, an x86-64 server linked as PIE would call into nowhere
+	if (reinterpret_cast<uintptr_t>(&PAWN::CreateTimer) > UINT32_MAX)
+		return AMX_ERR_INIT;
+
 	amx_CoreInit(amx);
 	amx_ConsoleInit(amx);
 	amx_FloatInit(amx);
@@ -421,6 +560,7 @@ int PAWN::Exec(AMX* amx, cell* retval, int index)
 
 int PAWN::FreeProgram(AMX* amx)
 {
+	stubs.erase(amx);
 	return aux_FreeProgram(amx);
 }
 
@@ -430,6 +570,49 @@ bool PAWN::IsCallbackPresent(AMX* amx, const char* name)
 	return (amx_FindPublic(amx, name, &idx) == AMX_ERR_NONE);
 }
 
+static const CallStub& PAWN_stub(AMX* amx, const char* name, const char* argl)
+{
+	unsigned long long key = (static_cast<unsigned long long>(Utils::hash(name, strlen(name) + 1)) << 32) | Utils::hash(argl, strlen(argl) + 1);
+	auto& stub = stubs[amx][key];
+
+	if (!stub.name.compare(name) && !stub.argl.compare(argl))
+		return stub;
+
+	int idx = 0;
+	int err = amx_FindPublic(amx, name, &idx);
+
+	if (err != AMX_ERR_NONE)
+		throw VaultException("PAWN runtime error (%d): \"%s\"", err, aux_StrError(err)).stacktrace();
+
+	unsigned int count = 0;
+
+	for (const char* type = argl; *type; ++type)
+		switch (*type)
+		{
+			case 'i':
+			case 'q':
+			case 'l':
+			case 'w':
+			case 'f':
+			case 'p':
+				break;
+
+			case 's':
+				++count;
+				break;
+
+			default:
+				throw VaultException("PAWN call: Unknown argument identifier %02X", *type).stacktrace();
+		}
+
+	stub.name = name;
+	stub.argl = argl;
+	stub.index = idx;
+	stub.strings = count;
+
+	return stub;
+}
+
 cell PAWN::Call(AMX* amx, const char* name, const char* argl, int buf, ...)
 {
 	va_list args;
@@ -439,16 +622,16 @@ cell PAWN::Call(AMX* amx, const char* name, const char* argl, int buf, ...)
 
 	try
 	{
-		int idx = 0;
+		const CallStub& stub = PAWN_stub(amx, name, argl);
+		int idx = stub.index;
 		int err = 0;
 
-		err = amx_FindPublic(amx, name, &idx);
-
-		if (err != AMX_ERR_NONE)
-			throw VaultException("PAWN runtime error (%d): \"%s\"", err, aux_StrError(err)).stacktrace();
-
-		unsigned int len = strlen(argl);
+		unsigned int len = stub.argl.length();
 		vector<cell> args_amx;
+		vector<char*> string_args;
+		args_amx.reserve(len);
+		string_args.reserve(stub.strings);
+		strings.reserve(stub.strings);
 
 		for (unsigned int i = 0; i < len; ++i)
 		{
@@ -478,11 +661,12 @@ cell PAWN::Call(AMX* amx, const char* name, const char* argl, int buf, ...)
 				}
 
 				case 'p':
-					args_amx.emplace_back(reinterpret_cast<unsigned int>(va_arg(args, void*)));
+					args_amx.emplace_back(static_cast<cell>(reinterpret_cast<uintptr_t>(va_arg(args, void*))));
 					break;
 
 				case 's':
-					args_amx.emplace_back(reinterpret_cast<unsigned int>(va_arg(args, char*)));
+					args_amx.emplace_back(0);
+					string_args.emplace_back(va_arg(args, char*));
 					break;
 
 				default:
@@ -490,13 +674,15 @@ cell PAWN::Call(AMX* amx, const char* name, const char* argl, int buf, ...)
 			}
 		}
 
+		unsigned int string_arg = string_args.size();
+
 		for (unsigned int i = len; i; --i)
 		{
 			switch (argl[i - 1])
 			{
 				case 's':
 				{
-					char* string = reinterpret_cast<char*>(static_cast<unsigned int>(args_amx[i - 1]));
+					char* string = string_args[--string_arg];
 					cell* store;
 					amx_PushString(amx, &store, string, 1, 0);
 					strings.emplace_back(store, string);
@@ -532,6 +718,8 @@ cell PAWN::Call(AMX* amx, const char* name, const char* argl, int buf, ...)
 		throw;
 	}
 
+	va_end(args);
+
 	return ret;
 }
 
@@ -542,15 +730,11 @@ cell PAWN::Call(AMX* amx, const char* name, const char* argl, const vector<boost
 
 	try
 	{
-		int idx = 0;
+		const CallStub& stub = PAWN_stub(amx, name, argl);
+		int idx = stub.index;
 		int err = 0;
 
-		err = amx_FindPublic(amx, name, &idx);
-
-		if (err != AMX_ERR_NONE)
-			throw VaultException("PAWN runtime error (%d): \"%s\"", err, aux_StrError(err)).stacktrace();
-
-		for (int i = strlen(argl) - 1; i >= 0; i--)
+		for (int i = stub.argl.length() - 1; i >= 0; i--)
 		{
 			switch (argl[i])
 			{
@@ -591,7 +775,7 @@ cell PAWN::Call(AMX* amx, const char* name, const char* argl, const vector<boost
 
 				case 'p':
 				{
-					cell value = (cell) boost::any_cast<void*>(args.at(i));
+					cell value = static_cast<cell>(reinterpret_cast<uintptr_t>(boost::any_cast<void*>(args.at(i))));
 					amx_Push(amx, value);
 					break;
 				}
@@ -29,6 +29,9 @@ class PAWN
 		static cell CreateTimerEx(AMX* amx, const cell* params) noexcept;
 		static cell MakePublic(AMX* amx, const cell* params) noexcept;
 		static cell CallPublic(AMX* amx, const cell* params) noexcept;
+		static cell GetPosBatch(AMX* amx, const cell* params) noexcept;
+		static cell GetCellBatch(AMX* amx, const cell* params) noexcept;
+		static cell GetActorValueBatch(AMX* amx, const cell* params) noexcept;
 
 		static int LoadProgram(AMX* amx, const char* filename, void* memblock);
 		static int Init(AMX* amx);
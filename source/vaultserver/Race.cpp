@@ -1,25 +1,25 @@
 #include "Race.hpp"
-#include "sqlite/sqlite3.h"
+#include "Database.hpp"
 
 using namespace std;
 using namespace DB;
 
 unordered_map<unsigned int, Race*> Race::races;
 
-Race::Race(const string& table, sqlite3_stmt* stmt)
+Race::Race(const string& table, const DatabaseRow& row)
 {
-	if (sqlite3_column_count(stmt) != 5)
+	if (row.GetColumnCount() != 5)
 		throw VaultException("Malformed input database (races): %s", table.c_str()).stacktrace();
 
-	unsigned int dlc = static_cast<unsigned int>(sqlite3_column_int(stmt, 4));
+	unsigned int dlc = static_cast<unsigned int>(row.GetInt(4));
 	// if DLC enabled
 
 	dlc <<= 24;
 
-	baseID = static_cast<unsigned int>(sqlite3_column_int(stmt, 0));
-	child = static_cast<bool>(sqlite3_column_int(stmt, 1));
-	younger = static_cast<unsigned int>(sqlite3_column_int(stmt, 2));
-	older = static_cast<unsigned int>(sqlite3_column_int(stmt, 3));
+	baseID = static_cast<unsigned int>(row.GetInt(0));
+	child = static_cast<bool>(row.GetInt(1));
+	younger = static_cast<unsigned int>(row.GetInt(2));
+	older = static_cast<unsigned int>(row.GetInt(3));
 
 	if (younger & 0xFF000000)
 	{
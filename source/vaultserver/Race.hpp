@@ -6,7 +6,7 @@
 
 #include <unordered_map>
 
-class sqlite3_stmt;
+class DatabaseRow;
 
 /**
  * \brief Represents a race
@@ -38,7 +38,7 @@ namespace DB
 			unsigned int GetMaxAge() const;
 			signed int GetAgeDifference(unsigned int race) const;
 
-			Race(const std::string& table, sqlite3_stmt* stmt);
+			Race(const std::string& table, const DatabaseRow& row);
 			~Race() = default;
 			// must never be called. only defined because vector requires it
 			Race(Race&&) { std::terminate(); }
@@ -1,29 +1,34 @@
 #include "Record.hpp"
 #include "Exterior.hpp"
 #include "Interior.hpp"
-#include "sqlite/sqlite3.h"
+#include "Database.hpp"
 
 #include <algorithm>
 
 using namespace std;
 using namespace DB;
 
+constexpr const char* Record::TYPES[];
 unordered_map<unsigned int, Record*> Record::data;
+array<vector<Record*>, Record::TYPE_COUNT> Record::types;
+unordered_set<string> Record::strings;
 
-Record::Record(const string& table, sqlite3_stmt* stmt)
+Record::Record(const string& table, const DatabaseRow& row)
 {
-	if (sqlite3_column_count(stmt) != 4)
+	if (row.GetColumnCount() != 4)
 		throw VaultException("Malformed input database (records): %s", table.c_str()).stacktrace();
 
-	unsigned int dlc = static_cast<unsigned int>(sqlite3_column_int(stmt, 3));
+	unsigned int dlc = static_cast<unsigned int>(row.GetInt(3));
 	// if DLC enabled
 
 	dlc <<= 24;
 
-	baseID = static_cast<unsigned int>(sqlite3_column_int(stmt, 0));
-	name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-	description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
-	type = table;
+	baseID = static_cast<unsigned int>(row.GetInt(0));
+	name = Intern(row.GetText(1));
+	description = Intern(row.GetText(2));
+	type = FourCC(table.c_str());
+	unsigned int index = Index(type);
+	mask = 1u << index;
 
 	if (baseID & 0xFF000000)
 	{
@@ -31,9 +36,25 @@ Record::Record(const string& table, sqlite3_stmt* stmt)
 		baseID |= dlc;
 	}
 	else
-		data.erase(baseID);
+	{
+		auto it = data.find(baseID);
+
+		if (it != data.end())
+		{
+			// swap the overridden record out of its type index
+			auto& records = types[Index(it->second->type)];
+			records[it->second->slot] = records.back();
+			records[it->second->slot]->slot = it->second->slot;
+			records.pop_back();
+			data.erase(it);
+		}
+	}
 
-	data.emplace(baseID, this);
+	if (data.emplace(baseID, this).second)
+	{
+		slot = types[index].size();
+		types[index].emplace_back(this);
+	}
 }
 
 Expected<Record*> Record::Lookup(unsigned int baseID)
@@ -46,44 +67,66 @@ Expected<Record*> Record::Lookup(unsigned int baseID)
 	return VaultException("No record with baseID %08X found", baseID);
 }
 
-Expected<Record*> Record::Lookup(unsigned int baseID, const string& type)
+Expected<Record*> Record::Lookup(unsigned int baseID, const char* type)
 {
 	auto it = data.find(baseID);
 
-	if (it != data.end() && !it->second->GetType().compare(type))
+	if (it != data.end() && it->second->type == FourCC(type))
 		return it->second;
 
-	return VaultException("No record with baseID %08X and type %s found", baseID, type.c_str());
+	return VaultException("No record with baseID %08X and type %s found", baseID, type);
 }
 
-Expected<Record*> Record::Lookup(unsigned int baseID, const vector<string>& types)
+Expected<Record*> Record::Lookup(unsigned int baseID, unsigned int mask)
 {
-	auto it = data.find(baseID);
+	Record* record = Find(baseID, mask);
 
-	if (it != data.end())
-	{
-		const string& type = it->second->GetType();
-
-		if (find(types.begin(), types.end(), type) != types.end())
-			return it->second;
-	}
+	if (record)
+		return record;
 
 	return VaultException("No record with baseID %08X found", baseID);
 }
 
+const vector<Record*>& Record::Lookup(const char* type)
+{
+	static const vector<Record*> empty;
+	unsigned int code = FourCC(type);
+
+	for (unsigned int i = 0; i < TYPE_COUNT; ++i)
+		if (FourCC(TYPES[i]) == code)
+			return types[i];
+
+	return empty;
+}
+
+Record* Record::Find(unsigned int baseID, unsigned int mask) noexcept
+{
+	auto it = data.find(baseID);
+	return it != data.end() && (it->second->mask & mask) ? it->second : nullptr;
+}
+
+unsigned int Record::Index(unsigned int type)
+{
+	for (unsigned int i = 0; i < TYPE_COUNT; ++i)
+		if (FourCC(TYPES[i]) == type)
+			return i;
+
+	throw VaultException("Unknown record type %08X", type).stacktrace();
+}
+
 bool Record::IsValidCell(unsigned int baseID) noexcept
 {
-	return Record::Lookup(baseID, "CELL").operator bool();
+	return Find(baseID, Mask("CELL"));
 }
 
 bool Record::IsValidWeather(unsigned int baseID) noexcept
 {
-	return Record::Lookup(baseID, "WTHR").operator bool();
+	return Find(baseID, Mask("WTHR"));
 }
 
 bool Record::IsValidSound(unsigned int baseID) noexcept
 {
-	return Record::Lookup(baseID, "SOUN").operator bool();
+	return Find(baseID, Mask("SOUN"));
 }
 
 bool Record::IsValidCoordinate(unsigned int baseID, float X, float Y, float Z) noexcept
@@ -108,20 +151,51 @@ unsigned int Record::GetBase() const
 
 const string& Record::GetName() const
 {
-	return name;
+	return *name;
 }
 
 const string& Record::GetDescription() const
 {
-	return description;
+	return *description;
+}
+
+string Record::TypeName(unsigned int code)
+{
+	string result;
+
+	for (; code; code >>= 8)
+		result.push_back(static_cast<char>(code & 0xFF));
+
+	return result;
 }
 
-const string& Record::GetType() const
+string Record::GetType() const
+{
+	return TypeName(type);
+}
+
+unsigned int Record::GetTypeCode() const
 {
 	return type;
 }
 
+unsigned int Record::GetTypeMask() const
+{
+	return mask;
+}
+
 void Record::SetDescription(const string& description)
 {
-	this->description = description;
+	if (custom)
+		*custom = description;
+	else
+		custom.reset(new string(description));
+
+	this->description = custom.get();
+}
+
+const string* Record::Intern(const char* str)
+{
+	// only called while loading. names repeat a lot and most descriptions are empty, share one copy of each
+	return &*strings.emplace(str).first;
 }
@@ -8,9 +8,11 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <array>
 #include <functional>
+#include <memory>
 
-class sqlite3_stmt;
+class DatabaseRow;
 
 /**
  * \brief Represents a game record
@@ -20,22 +22,77 @@ namespace DB
 {
 	class Record
 	{
+		public:
+			/**
+			 * \brief The record types known to the server, a type's position is its slot in the type indexes
+			 */
+			static constexpr const char* TYPES[] = {"CONT", "NPC_", "CREA", "LVLI", "ALCH", "AMMO", "ARMA", "ARMO", "BOOK", "ENCH", "KEYM", "MISC", "NOTE", "WEAP", "CELL", "IDLE", "WTHR", "STAT", "MSTT", "RACE", "LIGH", "DOOR", "TERM", "EXPL", "PROJ", "SOUN"};
+			static constexpr unsigned int TYPE_COUNT = sizeof(TYPES) / sizeof(TYPES[0]);
+
+			/**
+			 * \brief Returns the slot of a record type, throws on an unknown type
+			 */
+			static unsigned int Index(unsigned int type);
+
 		private:
 			static std::unordered_map<unsigned int, Record*> data;
+			static std::array<std::vector<Record*>, TYPE_COUNT> types;
+			static std::unordered_set<std::string> strings;
+
+			static const std::string* Intern(const char* str);
+			static Record* Find(unsigned int baseID, unsigned int mask) noexcept;
 
 			unsigned int baseID;
-			std::string name;
-			std::string description;
-			std::string type;
+			unsigned int type;
+			unsigned int mask;
+			unsigned int slot;
+			const std::string* name;
+			const std::string* description;
+			// descriptions set at runtime are owned by the record, only strings from the database are interned
+			std::unique_ptr<std::string> custom;
 
 			Record(const Record&) = delete;
 			Record& operator=(const Record&) = delete;
 
 		public:
+			/**
+			 * \brief Packs a four character record type like "WEAP" into an integer
+			 */
+			static constexpr unsigned int FourCC(const char* type)
+			{
+				unsigned int code = 0;
+
+				for (unsigned int i = 0; i < 4 && type[i]; ++i)
+					code |= static_cast<unsigned int>(static_cast<unsigned char>(type[i])) << (i * 8);
+
+				return code;
+			}
+
+			/**
+			 * \brief Returns a bitmask of record types for type-filtered lookups
+			 */
+			static constexpr unsigned int Mask(const char* type)
+			{
+				for (unsigned int i = 0; i < TYPE_COUNT; ++i)
+					if (FourCC(TYPES[i]) == FourCC(type))
+						return 1u << i;
+
+				return 0;
+			}
+
+			template<typename... Types>
+			static constexpr unsigned int Mask(const char* type, Types... types) { return Mask(type) | Mask(types...); }
+
+			/**
+			 * \brief Unpacks a record type packed by FourCC
+			 */
+			static std::string TypeName(unsigned int code);
+
 			static const std::unordered_map<unsigned int, Record*>& Get() { return data; }
 			static Expected<Record*> Lookup(unsigned int baseID);
-			static Expected<Record*> Lookup(unsigned int baseID, const std::string& type);
-			static Expected<Record*> Lookup(unsigned int baseID, const std::vector<std::string>& type);
+			static Expected<Record*> Lookup(unsigned int baseID, const char* type);
+			static Expected<Record*> Lookup(unsigned int baseID, unsigned int mask);
+			static const std::vector<Record*>& Lookup(const char* type);
 
 			static bool IsValidCell(unsigned int baseID) noexcept;
 			static bool IsValidWeather(unsigned int baseID) noexcept;
@@ -45,11 +102,13 @@ namespace DB
 			unsigned int GetBase() const;
 			const std::string& GetName() const;
 			const std::string& GetDescription() const;
-			const std::string& GetType() const;
+			std::string GetType() const;
+			unsigned int GetTypeCode() const;
+			unsigned int GetTypeMask() const;
 
 			void SetDescription(const std::string& description);
 
-			Record(const std::string& table, sqlite3_stmt* stmt);
+			Record(const std::string& table, const DatabaseRow& row);
 			~Record() = default;
 			// must never be called. only defined because vector requires it
 			Record(Record&&) { std::terminate(); }
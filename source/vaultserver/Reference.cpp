@@ -2,7 +2,8 @@
 #include "API.hpp"
 #include "Utils.hpp"
 #include "Exterior.hpp"
-#include "sqlite/sqlite3.h"
+#include "Record.hpp"
+#include "Database.hpp"
 
 #include <cmath>
 #include <algorithm>
@@ -13,38 +14,42 @@ using namespace Values;
 
 unordered_map<unsigned int, Reference*> Reference::refs;
 unordered_map<unsigned int, vector<Reference*>> Reference::cells;
+array<vector<Reference*>, Record::TYPE_COUNT> Reference::types;
+unordered_set<string> Reference::strings;
 
-Reference::Reference(const string& table, sqlite3_stmt* stmt)
+Reference::Reference(const string& table, const DatabaseRow& row)
 {
-	if (sqlite3_column_count(stmt) != 17)
+	if (row.GetColumnCount() != 17)
 		throw VaultException("Malformed input database (references): %s", table.c_str()).stacktrace();
 
-	unsigned int dlc = static_cast<unsigned int>(sqlite3_column_int(stmt, 16));
+	unsigned int dlc = static_cast<unsigned int>(row.GetInt(16));
 	// if DLC enabled
 
 	dlc <<= 24;
 
 	constexpr double degrees = 180.0 / M_PI;
 
-	type = Utils::str_replace(table, "refs_", "");
-	editor = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
-	refID = static_cast<unsigned int>(sqlite3_column_int(stmt, 1));
-	baseID = static_cast<unsigned int>(sqlite3_column_int(stmt, 2));
-	count = static_cast<unsigned int>(sqlite3_column_int(stmt, 3));
-	health = sqlite3_column_double(stmt, 4);
-	cell = static_cast<unsigned int>(sqlite3_column_int(stmt, 5));
-	pos = make_tuple(sqlite3_column_double(stmt, 6), sqlite3_column_double(stmt, 7), sqlite3_column_double(stmt, 8));
-	angle = make_tuple(sqlite3_column_double(stmt, 9) * degrees, sqlite3_column_double(stmt, 10) * degrees, sqlite3_column_double(stmt, 11) * degrees);
-	flags = static_cast<unsigned int>(sqlite3_column_int(stmt, 12));
-	lock = static_cast<unsigned int>(sqlite3_column_int(stmt, 13));
+	type = Record::FourCC(Utils::str_replace(table, "refs_", "").c_str());
+	slot = Record::Index(type);
+	// most references have no editor ID
+	editor = &*strings.emplace(row.GetText(0)).first;
+	refID = static_cast<unsigned int>(row.GetInt(1));
+	baseID = static_cast<unsigned int>(row.GetInt(2));
+	count = static_cast<unsigned int>(row.GetInt(3));
+	health = row.GetDouble(4);
+	cell = static_cast<unsigned int>(row.GetInt(5));
+	pos = make_tuple(row.GetDouble(6), row.GetDouble(7), row.GetDouble(8));
+	angle = make_tuple(row.GetDouble(9) * degrees, row.GetDouble(10) * degrees, row.GetDouble(11) * degrees);
+	flags = static_cast<unsigned int>(row.GetInt(12));
+	lock = static_cast<unsigned int>(row.GetInt(13));
 
 	if (lock == UINT_MAX) // -1
 		lock = Lock_Impossible; // requires key
 	else if (lock == UINT_MAX - 1) // -2
 		lock = Lock_Unlocked; // unlocked
 
-	key = static_cast<unsigned int>(sqlite3_column_int(stmt, 14));
-	link = static_cast<unsigned int>(sqlite3_column_int(stmt, 15));
+	key = static_cast<unsigned int>(row.GetInt(14));
+	link = static_cast<unsigned int>(row.GetInt(15));
 
 	if (cell & 0xFF000000)
 	{
@@ -110,25 +115,66 @@ Expected<Reference*> Reference::Lookup(unsigned int refID)
 	return VaultException("No reference with refID %08X found", refID);
 }
 
-vector<Reference*> Reference::Lookup(const std::string& type)
+Reference::Span Reference::Lookup(const char* type)
 {
-	vector<Reference*> data;
+	static const vector<Reference*> empty;
+	unsigned int code = Record::FourCC(type);
+
+	for (unsigned int i = 0; i < Record::TYPE_COUNT; ++i)
+		if (Record::FourCC(Record::TYPES[i]) == code)
+			return Span{types[i].begin(), types[i].end()};
+
+	return Span{empty.begin(), empty.end()};
+}
+
+Reference::Span Reference::Lookup(unsigned int cell, const char* type)
+{
+	static const vector<Reference*> empty;
+	unsigned int code = Record::FourCC(type);
+	auto it = cells.find(cell);
+
+	if (it == cells.end())
+		return Span{empty.begin(), empty.end()};
+
+	for (unsigned int i = 0; i < Record::TYPE_COUNT; ++i)
+		if (Record::FourCC(Record::TYPES[i]) == code)
+		{
+			auto first = lower_bound(it->second.begin(), it->second.end(), i, [](const Reference* reference, unsigned int slot) { return reference->slot < slot; });
+			auto last = upper_bound(first, it->second.end(), i, [](unsigned int slot, const Reference* reference) { return slot < reference->slot; });
+			return Span{first, last};
+		}
+
+	return Span{empty.begin(), empty.end()};
+}
+
+void Reference::Index()
+{
+	for (auto& type : types)
+		type.clear();
 
 	for (const auto& ref : refs)
-		if (!ref.second->GetType().compare(type))
-			data.emplace_back(ref.second);
+		types[ref.second->slot].emplace_back(ref.second);
+
+	for (auto& type : types)
+		sort(type.begin(), type.end(), [](const Reference* a, const Reference* b) { return a->refID < b->refID; });
 
-	return data;
+	for (auto& cell : cells)
+		sort(cell.second.begin(), cell.second.end(), [](const Reference* a, const Reference* b) { return a->slot < b->slot || (a->slot == b->slot && a->refID < b->refID); });
+}
+
+string Reference::GetType() const
+{
+	return Record::TypeName(type);
 }
 
-const string& Reference::GetType() const
+unsigned int Reference::GetTypeCode() const
 {
 	return type;
 }
 
 const string& Reference::GetEditor() const
 {
-	return editor;
+	return *editor;
 }
 
 unsigned int Reference::GetReference() const
@@ -3,13 +3,16 @@
 
 #include "vaultserver.hpp"
 #include "Expected.hpp"
+#include "Record.hpp"
 
+#include <array>
 #include <vector>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 
-class sqlite3_stmt;
+class DatabaseRow;
 
 /**
  * \brief Represents a game reference
@@ -19,12 +22,31 @@ namespace DB
 {
 	class Reference
 	{
+		public:
+			/**
+			 * \brief A range of references in one of the indexes
+			 */
+			struct Span
+			{
+				std::vector<Reference*>::const_iterator first, last;
+
+				std::vector<Reference*>::const_iterator begin() const { return first; }
+				std::vector<Reference*>::const_iterator end() const { return last; }
+				std::size_t size() const { return last - first; }
+				bool empty() const { return first == last; }
+			};
+
 		private:
 			static std::unordered_map<unsigned int, Reference*> refs;
+			// sorted by type slot and refID once indexed, so the references of one type in a cell are consecutive
 			static std::unordered_map<unsigned int, std::vector<Reference*>> cells;
+			static std::array<std::vector<Reference*>, Record::TYPE_COUNT> types;
+
+			static std::unordered_set<std::string> strings;
 
-			std::string type;
-			std::string editor;
+			unsigned int type;
+			unsigned int slot;
+			const std::string* editor;
 			unsigned int refID;
 			unsigned int baseID;
 			unsigned int count;
@@ -43,9 +65,21 @@ namespace DB
 			static const std::unordered_map<unsigned int, Reference*>& Get() { return refs; }
 			static const std::unordered_map<unsigned int, std::vector<Reference*>>& GetCells() { return cells; }
 			static Expected<Reference*> Lookup(unsigned int refID);
-			static std::vector<Reference*> Lookup(const std::string& type);
+			/**
+			 * \brief Returns all references of a given type
+			 */
+			static Span Lookup(const char* type);
+			/**
+			 * \brief Returns the references of a given type in a cell
+			 */
+			static Span Lookup(unsigned int cell, const char* type);
+			/**
+			 * \brief Builds the type indexes, must be called once all references have been loaded
+			 */
+			static void Index();
 
-			const std::string& GetType() const;
+			std::string GetType() const;
+			unsigned int GetTypeCode() const;
 			const std::string& GetEditor() const;
 			unsigned int GetReference() const;
 			unsigned int GetBase() const;
@@ -59,7 +93,7 @@ namespace DB
 			unsigned int GetKey() const;
 			unsigned int GetLink() const;
 
-			Reference(const std::string& table, sqlite3_stmt* stmt);
+			Reference(const std::string& table, const DatabaseRow& row);
 			~Reference() = default;
 			// must never be called. only defined because vector requires it
 			Reference(Reference&&) { std::terminate(); }
@@ -4,8 +4,12 @@
 #include "Client.hpp"
 #include "Network.hpp"
 #include "Game.hpp"
+#include "Grid.hpp"
 #include "amx/amxaux.h"
 #include "time/time64.h"
+#include "vaultscript/vaultscript.h"
+
+#include <cstddef>
 
 using namespace std;
 using namespace RakNet;
@@ -13,6 +17,7 @@ using namespace Values;
 
 Script::ScriptList Script::scripts;
 Script::DeletedObjects Script::deletedStatic;
+Script::LoadedCells Script::loadedCells;
 Script::GameTime Script::time;
 Script::GameWeather Script::weather;
 
@@ -20,6 +25,14 @@ template<typename... Types>
 constexpr char TypeString<Types...>::value[];
 constexpr ScriptFunctionData Script::functions[];
 constexpr ScriptCallbackData Script::callbacks[];
+constexpr unsigned int Script::batched[];
+
+static_assert(sizeof(ScriptEvent) == sizeof(vaultmp::Event), "ScriptEvent doesn't match Event in vaultscript.h");
+static_assert(offsetof(ScriptEvent, type) == offsetof(vaultmp::Event, type), "ScriptEvent doesn't match Event in vaultscript.h");
+static_assert(offsetof(ScriptEvent, id) == offsetof(vaultmp::Event, id), "ScriptEvent doesn't match Event in vaultscript.h");
+static_assert(offsetof(ScriptEvent, other) == offsetof(vaultmp::Event, other), "ScriptEvent doesn't match Event in vaultscript.h");
+static_assert(offsetof(ScriptEvent, value) == offsetof(vaultmp::Event, value), "ScriptEvent doesn't match Event in vaultscript.h");
+static_assert(offsetof(ScriptEvent, number) == offsetof(vaultmp::Event, number), "ScriptEvent doesn't match Event in vaultscript.h");
 
 Script::Script(const char* path)
 {
@@ -50,6 +63,7 @@ Script::Script(const char* path)
 		{
 			this->lib = handle;
 			this->cpp_script = true;
+			this->batch_ = GetScript<decltype(batch_)>("OnEventBatch");
 
 			const char* vaultprefix = GetScript<const char*>("vaultprefix");
 			string vpf(vaultprefix);
@@ -78,6 +92,7 @@ Script::Script(const char* path)
 
 			this->amx = vaultscript;
 			this->cpp_script = false;
+			this->batch_ = nullptr;
 			int err = 0;
 
 			err = PAWN::LoadProgram(vaultscript, path, nullptr);
@@ -150,12 +165,40 @@ void Script::Initialize()
 	static_assert(sizeof(chrono::system_clock::rep) == sizeof(Time64_T), "Underlying representation of chrono::system_clock should be 64bit integral");
 
 	deletedStatic.clear();
+	loadedCells.clear();
 
 	time.first = chrono::system_clock::now();
 	time.second = 1.0;
 	CreateTimer(&Timer_GameTime, 1000);
 
 	weather = DEFAULT_WEATHER;
+}
+
+void Script::LoadCells(unsigned int cell, Client* except)
+{
+	auto exterior = DB::Exterior::Lookup(cell);
+	Player::CellContext context;
+
+	if (exterior)
+		context = exterior->GetAdjacents();
+	else
+		context = {{cell, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u}};
+
+	for (auto cell : context)
+		if (cell)
+			InstantiateCell(cell, except);
+}
+
+void Script::InstantiateCell(unsigned int cell, Client* except)
+{
+	if (!loadedCells.emplace(cell).second)
+		return;
+
+	const auto& cells = DB::Reference::GetCells();
+	auto it = cells.find(cell);
+
+	if (it == cells.end())
+		return;
 
 	auto object_init = [](Object* object, const DB::Reference* reference)
 	{
@@ -173,50 +216,57 @@ void Script::Initialize()
 		object->SetLockLevel(lock);
 	};
 
-	const auto& references = DB::Reference::Get();
-	const auto& cells = DB::Reference::GetCells();
-	unordered_set<unsigned int> refs_cells;
-	transform(cells.begin(), cells.end(), inserter(refs_cells, refs_cells.end()), [](const pair<const unsigned int, vector<DB::Reference*>>& cell) { return cell.first; });
+	NetworkResponse response;
+	const DB::Reference* anchor = nullptr;
+	bool anchored = false;
 
-	for (const auto& reference : references)
+	for (const auto* data : it->second)
 	{
 		// FIXME dlc support
-		if (reference.first & 0xFF000000)
+		if (data->GetReference() & 0xFF000000)
 			continue;
 
-		const auto* data = reference.second;
-		unsigned int cell = data->GetCell();
-
-		switch (Utils::hash(data->GetType().c_str(), data->GetType().length() + 1))
+		switch (data->GetTypeCode())
 		{
-			case Utils::hash("CONT"):
-				GameFactory::Operate<Container>(GameFactory::Create<Container, FailPolicy::Exception>(data->GetReference(), data->GetBase()), [&object_init, data](Container* container) {
+			case DB::Record::FourCC("CONT"):
+				GameFactory::Operate<Container>(GameFactory::Create<Container, FailPolicy::Exception>(data->GetReference(), data->GetBase()), [&object_init, &response, except, data](Container* container) {
 					object_init(container, data);
+					response.emplace_back(container->toPacket(), HIGH_PRIORITY, RELIABLE_ORDERED, CHANNEL_GAME, Client::GetNetworkList(except));
 				});
 				break;
 
-			case Utils::hash("TERM"):
-				GameFactory::Operate<Object>(GameFactory::Create<Object, FailPolicy::Exception>(data->GetReference(), data->GetBase()), [&object_init, data](Object* object) {
+			case DB::Record::FourCC("TERM"):
+				GameFactory::Operate<Object>(GameFactory::Create<Object, FailPolicy::Exception>(data->GetReference(), data->GetBase()), [&object_init, &response, except, data](Object* object) {
 					object_init(object, data);
 					object->SetLockLevel(DB::Terminal::Lookup(data->GetBase())->GetLock());
+					response.emplace_back(object->toPacket(), HIGH_PRIORITY, RELIABLE_ORDERED, CHANNEL_GAME, Client::GetNetworkList(except));
 				});
 				break;
 
-			case Utils::hash("STAT"):
-				if (refs_cells.count(cell))
-					GameFactory::Operate<Object>(GameFactory::Create<Object, FailPolicy::Exception>(data->GetReference(), data->GetBase()), [&object_init, data](Object* object) {
-						object_init(object, data);
-					});
-				break;
+			case DB::Record::FourCC("STAT"):
+				// statics are only needed as an anchor for cells without any other reference
+				if (!anchor)
+					anchor = data;
+				continue;
 
 			default:
-				GameFactory::Operate<Object>(GameFactory::Create<Object, FailPolicy::Exception>(data->GetReference(), data->GetBase()), [&object_init, data](Object* object) {
+				GameFactory::Operate<Object>(GameFactory::Create<Object, FailPolicy::Exception>(data->GetReference(), data->GetBase()), [&object_init, &response, except, data](Object* object) {
 					object_init(object, data);
+					response.emplace_back(object->toPacket(), HIGH_PRIORITY, RELIABLE_ORDERED, CHANNEL_GAME, Client::GetNetworkList(except));
 				});
 		}
 
-		refs_cells.erase(cell);
+		anchored = true;
 	}
+
+	if (!anchored && anchor)
+		GameFactory::Operate<Object>(GameFactory::Create<Object, FailPolicy::Exception>(anchor->GetReference(), anchor->GetBase()), [&object_init, &response, except, anchor](Object* object) {
+			object_init(object, anchor);
+			response.emplace_back(object->toPacket(), HIGH_PRIORITY, RELIABLE_ORDERED, CHANNEL_GAME, Client::GetNetworkList(except));
+		});
+
+	if (!response.empty())
+		Network::Queue(move(response));
 }
 
 void Script::UnloadScripts()
@@ -226,6 +276,25 @@ void Script::UnloadScripts()
 	scripts.clear();
 }
 
+void Script::DispatchEvents()
+{
+	vector<ScriptEvent> events;
+
+	for (auto& script : scripts)
+	{
+		if (script->events_.empty())
+			continue;
+
+		// the batch may raise further events, they are delivered in the next tick
+		events.swap(script->events_);
+		script->batch_(events.data(), events.size());
+		events.clear();
+
+		if (script->events_.empty())
+			events.swap(script->events_);
+	}
+}
+
 void Script::GetArguments(vector<boost::any>& params, va_list args, const string& def)
 {
 	params.reserve(def.length());
@@ -599,6 +668,23 @@ void Script::SetSpawnCell(unsigned int cell) noexcept
 	catch (...) {}
 }
 
+bool Script::LoadCell(unsigned int cell) noexcept
+{
+	if (!DB::Record::IsValidCell(cell))
+		return false;
+
+	try
+	{
+		InstantiateCell(cell, nullptr);
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	return true;
+}
+
 void Script::SetGameWeather(unsigned int weather) noexcept
 {
 	if (Script::weather == weather)
@@ -886,12 +972,9 @@ unsigned int Script::GetConnection(NetworkID id) noexcept
 	return value;
 }
 
-unsigned int Script::GetList(unsigned int type, NetworkID** data) noexcept
+unsigned int Script::GetList(unsigned int type, NetworkID* data, unsigned int size) noexcept
 {
-	static vector<NetworkID> _data;
-	_data = GameFactory::GetByType(type);
-	*data = &_data[0];
-	return _data.size();
+	return GameFactory::GetByType(type, data, size);
 }
 
 unsigned int Script::GetGameWeather() noexcept
@@ -967,6 +1050,30 @@ void Script::GetPos(NetworkID id, double* X, double* Y, double* Z) noexcept
 	});
 }
 
+unsigned int Script::GetPosBatch(const NetworkID* ids, unsigned int count, double* X, double* Y, double* Z) noexcept
+{
+	return GameFactory::Operate<Object, RETURN_EXPECTED>(vector<NetworkID>(ids, ids + count), [count, X, Y, Z](Objects& objects) {
+		unsigned int found = 0;
+
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			if (!objects[i])
+			{
+				X[i] = Y[i] = Z[i] = 0.00;
+				continue;
+			}
+
+			const auto& pos = objects[i]->GetNetworkPos();
+			X[i] = get<0>(pos);
+			Y[i] = get<1>(pos);
+			Z[i] = get<2>(pos);
+			++found;
+		}
+
+		return found;
+	});
+}
+
 void Script::GetAngle(NetworkID id, double* X, double* Y, double* Z) noexcept
 {
 	*X = 0.00;
@@ -988,6 +1095,21 @@ unsigned int Script::GetCell(NetworkID id) noexcept
 	});
 }
 
+unsigned int Script::GetCellBatch(const NetworkID* ids, unsigned int count, unsigned int* cells) noexcept
+{
+	return GameFactory::Operate<Object, RETURN_EXPECTED>(vector<NetworkID>(ids, ids + count), [count, cells](Objects& objects) {
+		unsigned int found = 0;
+
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			cells[i] = objects[i] ? objects[i]->GetNetworkCell() : 0u;
+			found += objects[i] != nullptr;
+		}
+
+		return found;
+	});
+}
+
 unsigned int Script::GetLock(NetworkID id) noexcept
 {
 	return GameFactory::Operate<Object, RETURN_VALIDATED>(id, [](Object* object) {
@@ -1018,6 +1140,20 @@ bool Script::IsNearPoint(NetworkID id, double X, double Y, double Z, double R) n
 	});
 }
 
+unsigned int Script::GetObjectsInRadius(unsigned int cell, double X, double Y, double Z, double R, unsigned int type, NetworkID* data, unsigned int size) noexcept
+{
+	auto ids = Grid::GetInRadius(cell, X, Y, Z, R);
+	ids.erase(remove_if(ids.begin(), ids.end(), [type](NetworkID id) { return !(GameFactory::GetType(id) & type); }), ids.end());
+	return FillList(ids, data, size);
+}
+
+unsigned int Script::GetObjectsInCell(unsigned int cell, unsigned int type, NetworkID* data, unsigned int size) noexcept
+{
+	auto ids = Grid::GetInCell(cell);
+	ids.erase(remove_if(ids.begin(), ids.end(), [type](NetworkID id) { return !(GameFactory::GetType(id) & type); }), ids.end());
+	return FillList(ids, data, size);
+}
+
 NetworkID Script::GetItemContainer(NetworkID id) noexcept
 {
 	return GameFactory::Operate<Item, RETURN_VALIDATED>(id, [](Item* item) {
@@ -1067,18 +1203,10 @@ unsigned int Script::GetContainerItemCount(NetworkID id, unsigned int baseID) no
 	});
 }
 
-unsigned int Script::GetContainerItemList(NetworkID id, NetworkID** data) noexcept
+unsigned int Script::GetContainerItemList(NetworkID id, NetworkID* data, unsigned int size) noexcept
 {
-	static vector<NetworkID> _data;
-
-	return GameFactory::Operate<ItemList, RETURN_VALIDATED>(id, [id, data](ItemList* itemlist) {
-		_data.assign(itemlist->GetItemList().begin(), itemlist->GetItemList().end());
-		unsigned int size = _data.size();
-
-		if (size)
-			*data = &_data[0];
-
-		return size;
+	return GameFactory::Operate<ItemList, RETURN_VALIDATED>(id, [data, size](ItemList* itemlist) {
+		return FillList(itemlist->GetItemList(), data, size);
 	});
 }
 
@@ -1089,6 +1217,21 @@ double Script::GetActorValue(NetworkID id, unsigned char index) noexcept
 	});
 }
 
+unsigned int Script::GetActorValueBatch(const NetworkID* ids, unsigned int count, unsigned char index, double* values) noexcept
+{
+	return GameFactory::Operate<Actor, RETURN_EXPECTED>(vector<NetworkID>(ids, ids + count), [count, index, values](Actors& actors) {
+		unsigned int found = 0;
+
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			values[i] = actors[i] ? actors[i]->GetActorValue(index) : 0.00;
+			found += actors[i] != nullptr;
+		}
+
+		return found;
+	});
+}
+
 double Script::GetActorBaseValue(NetworkID id, unsigned char index) noexcept
 {
 	return GameFactory::Operate<Actor, RETURN_VALIDATED>(id, [index](Actor* actor) {
@@ -1187,19 +1330,10 @@ unsigned int Script::GetPlayerWindowCount(NetworkID id) noexcept
 	});
 }
 
-unsigned int Script::GetPlayerWindowList(NetworkID id, NetworkID** data) noexcept
+unsigned int Script::GetPlayerWindowList(NetworkID id, NetworkID* data, unsigned int size) noexcept
 {
-	static vector<NetworkID> _data;
-
-	return GameFactory::Operate<Player, RETURN_VALIDATED>(id, [data](Player* player) {
-		const auto& windows = player->GetPlayerWindows();
-		_data.assign(windows.begin(), windows.end());
-		unsigned int size = _data.size();
-
-		if (size)
-			*data = &_data[0];
-
-		return size;
+	return GameFactory::Operate<Player, RETURN_VALIDATED>(id, [data, size](Player* player) {
+		return FillList(player->GetPlayerWindows(), data, size);
 	});
 }
 
@@ -1236,7 +1370,9 @@ NetworkID Script::CreateObject(unsigned int baseID, unsigned int cell, double X,
 
 bool Script::CreateVolatile(NetworkID id, unsigned int baseID, double aX, double aY, double aZ) noexcept
 {
-	if (!DB::Record::Lookup(baseID, vector<string>{"EXPL", "PROJ"}))
+	constexpr unsigned int types = DB::Record::Mask("EXPL", "PROJ");
+
+	if (!DB::Record::Lookup(baseID, types))
 		return false;
 
 	if (!Object::IsValidAngle(Axis_X, aX) || !Object::IsValidAngle(Axis_Z, aZ))
@@ -1375,7 +1511,10 @@ bool Script::SetPos(NetworkID id, double X, double Y, double Z) noexcept
 	});
 
 	if (success && new_cell_)
+	{
+		LoadCells(new_cell_);
 		Call<CBI("OnCellChange")>(id, new_cell_);
+	}
 
 	return success;
 }
@@ -1500,7 +1639,10 @@ bool Script::SetCell(NetworkID id, unsigned int cell, double X, double Y, double
 	});
 
 	if (success && cell)
+	{
+		LoadCells(cell);
 		Call<CBI("OnCellChange")>(id, cell);
+	}
 
 	return success;
 }
@@ -1872,9 +2014,9 @@ NetworkID Script::AddItem(NetworkID id, unsigned int baseID, unsigned int count,
 
 void Script::AddItemList(NetworkID id, NetworkID source, unsigned int baseID) noexcept
 {
-	GameFactory::Operate<ItemList, RETURN_EXPECTED>({id, source}, [id, source, baseID](ItemLists& itemlists) {
+	auto data = GameFactory::Operate<ItemList, RETURN_EXPECTED>({id, source}, [id, source, baseID](ItemLists& itemlists) -> ItemList::AddItemsOp {
 		if (!itemlists[0])
-			return;
+			return {};
 
 		if (itemlists[1])
 		{
@@ -1890,18 +2032,46 @@ void Script::AddItemList(NetworkID id, NetworkID source, unsigned int baseID) no
 		}
 		else if (baseID)
 		{
-			const auto& items = DB::BaseContainer::Lookup(baseID);
+			ItemList::Entries entries;
 
-			for (const auto* item : items)
+			for (const auto* item : DB::BaseContainer::Lookup(baseID))
 			{
 				// FIXME dlc support
 				if (item->GetItem() & 0xFF000000)
 					continue;
 
-				AddItem(id, item->GetItem(), item->GetCount(), item->GetCondition(), true);
+				entries.emplace_back(item->GetItem(), item->GetCount(), item->GetCondition());
 			}
+
+			auto diff = itemlists[0]->AddItems(entries, true);
+
+			if (GameFactory::Exists<Container>(id))
+			{
+				NetworkResponse response;
+
+				GameFactory::Operate<Item>(diff.first, [&response](Items& items) {
+					for (auto item : items)
+						response.emplace_back(item->toPacket(), HIGH_PRIORITY, RELIABLE_ORDERED, CHANNEL_GAME, Client::GetNetworkList(nullptr));
+				});
+
+				for (const auto& stack : diff.second)
+					response.emplace_back(PacketFactory::Create<pTypes::ID_UPDATE_COUNT>(stack.first, stack.second, true), HIGH_PRIORITY, RELIABLE_ORDERED, CHANNEL_GAME, Client::GetNetworkList(nullptr));
+
+				if (!response.empty())
+					Network::Queue(move(response));
+			}
+
+			return diff;
 		}
+
+		return {};
 	});
+
+	for (auto item : data.first)
+		Call<CBI("OnCreate")>(item);
+
+	for (const auto& stack : data.second)
+		Call<CBI("OnItemCountChange")>(stack.first, stack.second);
 }
 
 unsigned int Script::RemoveItem(NetworkID id, unsigned int baseID, unsigned int count, bool silent) noexcept
@@ -2484,24 +2654,16 @@ unsigned int Script::GetWindowChildCount(NetworkID id) noexcept
 	});
 }
 
-unsigned int Script::GetWindowChildList(NetworkID id, NetworkID** data) noexcept
+unsigned int Script::GetWindowChildList(NetworkID id, NetworkID* data, unsigned int size) noexcept
 {
-	static vector<NetworkID> _data;
-
-	return GameFactory::Operate<Window, RETURN_VALIDATED>(id, [id, data](Window*) {
-		const auto& childs_ = Window::GetChilds();
+	return GameFactory::Operate<Window, RETURN_VALIDATED>(id, [id, data, size](Window*) {
+		const auto& childs = Window::GetChilds();
+		auto it = childs.find(id);
 
-		if (!childs_.count(id))
+		if (it == childs.end())
 			return 0u;
 
-		const auto& childs = childs_.find(id)->second;
-		_data.assign(childs.begin(), childs.end());
-		unsigned int size = _data.size();
-
-		if (size)
-			*data = &_data[0];
-
-		return size;
+		return FillList(it->second, data, size);
 	});
 }
 
@@ -2611,19 +2773,10 @@ unsigned int Script::GetListItemCount(NetworkID id) noexcept
 	});
 }
 
-unsigned int Script::GetListItemList(NetworkID id, NetworkID** data) noexcept
+unsigned int Script::GetListItemList(NetworkID id, NetworkID* data, unsigned int size) noexcept
 {
-	static vector<NetworkID> _data;
-
-	return GameFactory::Operate<List, RETURN_VALIDATED>(id, [id, data](List* list) {
-		const auto& listitems = list->GetItemList();
-		_data.assign(listitems.begin(), listitems.end());
-		unsigned int size = _data.size();
-
-		if (size)
-			*data = &_data[0];
-
-		return size;
+	return GameFactory::Operate<List, RETURN_VALIDATED>(id, [data, size](List* list) {
+		return FillList(list->GetItemList(), data, size);
 	});
 }
 
@@ -2634,20 +2787,21 @@ unsigned int Script::GetListSelectedItemCount(NetworkID id) noexcept
 	});
 }
 
-unsigned int Script::GetListSelectedItemList(NetworkID id, NetworkID** data) noexcept
+unsigned int Script::GetListSelectedItemList(NetworkID id, NetworkID* data, unsigned int size) noexcept
 {
-	static vector<NetworkID> _data;
+	return GameFactory::Operate<List, RETURN_VALIDATED>(id, [data, size](List* list) {
+		unsigned int count = 0;
 
-	return GameFactory::Operate<List, RETURN_VALIDATED>(id, [id, data](List* list) {
-		const auto& listitems = list->GetItemList();
-		_data.clear();
-		copy_if(listitems.begin(), listitems.end(), back_inserter(_data), [](NetworkID listitem) { return GameFactory::Get<ListItem>(listitem)->GetSelected(); });
-		unsigned int size = _data.size();
+		for (NetworkID listitem : list->GetItemList())
+			if (GameFactory::Get<ListItem>(listitem)->GetSelected())
+			{
+				if (count < size)
+					data[count] = listitem;
 
-		if (size)
-			*data = &_data[0];
+				++count;
+			}
 
-		return size;
+		return count;
 	});
 }
 
@@ -3133,8 +3287,8 @@ bool Script::SetListMultiSelect(NetworkID id, bool multiselect)
 
 		if (!multiselect)
 		{
-			NetworkID* selected;
-			unsigned int count = GetListSelectedItemList(id, &selected);
+			vector<NetworkID> selected(GetListSelectedItemCount(id));
+			unsigned int count = min(GetListSelectedItemList(id, selected.data(), selected.size()), static_cast<unsigned int>(selected.size()));
 
 			while (count > 1)
 			{
@@ -3258,10 +3412,10 @@ bool Script::SetListItemSelected(NetworkID id, bool selected) noexcept
 	bool success = GameFactory::Operate<List, BOOL_VALIDATED>(list, [id, selected, &previous](List* list) {
 		if (selected && !list->GetMultiSelect())
 		{
-			NetworkID* selected;
+			NetworkID item;
 
-			if (GetListSelectedItemList(list->GetNetworkID(), &selected))
-				previous = selected[0];
+			if (GetListSelectedItemList(list->GetNetworkID(), &item, 1))
+				previous = item;
 		}
 
 		GameFactory::Operate<ListItem>(id, [selected](ListItem* listitem) {
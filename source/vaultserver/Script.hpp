@@ -26,17 +26,22 @@
 
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <climits>
 #include <memory>
 #include <chrono>
 #include <regex>
 
+class Client;
+
 template<typename T> struct sizeof_void { enum { value = sizeof(T) }; };
 template<> struct sizeof_void<void> { enum { value = 0 }; };
 
 template<typename T, size_t t> struct TypeChar { static_assert(!t, "Unsupported type in variadic type list"); };
 template<typename T> struct TypeChar<T*, sizeof(void*)> { enum { value = 'p' }; };
 template<> struct TypeChar<double*, sizeof(double*)> { enum { value = 'd' }; };
-template<> struct TypeChar<RakNet::NetworkID**, sizeof(RakNet::NetworkID**)> { enum { value = 'n' }; };
+template<> struct TypeChar<RakNet::NetworkID*, sizeof(RakNet::NetworkID*)> { enum { value = 'n' }; };
 template<typename T> struct TypeChar<T, sizeof(uint8_t)> { enum { value = std::is_signed<T>::value ? 'q' : 'i' }; };
 template<typename T> struct TypeChar<T, sizeof(uint16_t)> { enum { value = std::is_signed<T>::value ? 'q' : 'i' }; };
 template<typename T> struct TypeChar<T, sizeof(uint32_t)> { enum { value = std::is_signed<T>::value ? 'q' : 'i' }; };
@@ -49,7 +54,7 @@ template<> struct TypeChar<void, sizeof_void<void>::value> { enum { value = 'v'
 template<const char t> struct CharType { static_assert(!t, "Unsupported type in variadic type list"); };
 template<> struct CharType<'p'> { typedef void* type; };
 template<> struct CharType<'d'> { typedef double* type; };
-template<> struct CharType<'n'> { typedef RakNet::NetworkID** type; };
+template<> struct CharType<'n'> { typedef RakNet::NetworkID* type; };
 template<> struct CharType<'q'> { typedef signed int type; };
 template<> struct CharType<'i'> { typedef unsigned int type; };
 template<> struct CharType<'w'> { typedef signed long long type; };
@@ -142,6 +147,21 @@ struct SystemInterface
 #endif
 };
 
+/**
+ * \brief A callback deferred to the end of the tick
+ *
+ * Layout matches Event in vaultscript.h
+ */
+
+struct ScriptEvent
+{
+	unsigned int type;
+	RakNet::NetworkID id;
+	RakNet::NetworkID other;
+	unsigned int value;
+	double number;
+};
+
 /**
  * \brief Maintains communication with a script
  *
@@ -161,9 +181,21 @@ class Script
 
 		bool cpp_script;
 		std::unordered_map<unsigned int, FunctionEllipsis<void>> callbacks_;
+		Function<void, const ScriptEvent*, unsigned int> batch_;
+		std::vector<ScriptEvent> events_;
 
 		static void GetArguments(std::vector<boost::any>& params, va_list args, const std::string& def);
 
+		/**
+		 * \brief Copies at most size IDs of source into data and returns the size of source
+		 */
+		template<typename T>
+		static unsigned int FillList(const T& source, RakNet::NetworkID* data, unsigned int size) noexcept
+		{
+			std::copy_n(source.begin(), std::min(size, static_cast<unsigned int>(source.size())), data);
+			return source.size();
+		}
+
 		template<typename R>
 		R GetScript(const char* name)
 		{
@@ -191,12 +223,16 @@ class Script
 		typedef std::unordered_map<unsigned int, std::vector<unsigned int>> DeletedObjects;
 		typedef std::pair<std::chrono::system_clock::time_point, double> GameTime;
 		typedef unsigned int GameWeather;
+		typedef std::unordered_set<unsigned int> LoadedCells;
 
 		static ScriptList scripts;
 		static DeletedObjects deletedStatic;
+		static LoadedCells loadedCells;
 		static GameTime time;
 		static GameWeather weather;
 
+		static void InstantiateCell(unsigned int cell, Client* except);
+
 		Script(const Script&) = delete;
 		Script& operator=(const Script&) = delete;
 
@@ -205,9 +241,20 @@ class Script
 
 		static void LoadScripts(char* scripts, char* base);
 		static void Initialize();
+		/**
+		 * \brief Instantiates the persistent references of a cell and its adjacent exterior cells on first use
+		 *
+		 * New objects are sent to every client except the given one. Persistent references don't exist before their
+		 * cell was entered by a player or loaded with LoadCell, OnServerInit sees none of them
+		 */
+		static void LoadCells(unsigned int cell, Client* except = nullptr);
 		static void UnloadScripts();
+		static void DispatchEvents();
 
 		static RakNet::NetworkID CreateTimer(ScriptFunc timer, unsigned int interval) noexcept;
+		/**
+		 * \brief Creates a timer with arguments, C++ timers take at most ScriptFunction::MAX_ARGS arguments
+		 */
 		static RakNet::NetworkID CreateTimerEx(ScriptFunc timer, unsigned int interval, const char* def, ...) noexcept;
 		static RakNet::NetworkID CreateTimerPAWN(ScriptFuncPAWN timer, AMX* amx, unsigned int interval) noexcept;
 		static RakNet::NetworkID CreateTimerPAWNEx(ScriptFuncPAWN timer, AMX* amx, unsigned int interval, const char* def, const std::vector<boost::any>& args) noexcept;
@@ -216,6 +263,9 @@ class Script
 		static void SetupContainer(Container* container, unsigned int cell, float X, float Y, float Z) noexcept;
 		static void SetupActor(Actor* actor, unsigned int cell, float X, float Y, float Z) noexcept;
 		static void KillTimer(RakNet::NetworkID id = 0) noexcept;
+		/**
+		 * \brief Registers a public, C++ publics take at most ScriptFunction::MAX_ARGS arguments
+		 */
 		static void MakePublic(ScriptFunc _public, const char* name, const char* def) noexcept;
 		static void MakePublicPAWN(ScriptFuncPAWN _public, AMX* amx, const char* name, const char* def) noexcept;
 		static unsigned long long CallPublic(const char* name, ...) noexcept;
@@ -236,6 +286,7 @@ class Script
 		static bool UIMessage(RakNet::NetworkID id, const char* message, unsigned char emoticon) noexcept;
 		static bool ChatMessage(RakNet::NetworkID id, const char* message) noexcept;
 		static void SetSpawnCell(unsigned int cell) noexcept;
+		static bool LoadCell(unsigned int cell) noexcept;
 		static void SetGameWeather(unsigned int weather) noexcept;
 		static void SetGameTime(signed long long time) noexcept;
 		static void SetGameYear(unsigned int year) noexcept;
@@ -262,7 +313,7 @@ class Script
 		static bool IsList(RakNet::NetworkID id) noexcept;
 		static bool IsChatbox(RakNet::NetworkID id) noexcept;
 		static unsigned int GetConnection(RakNet::NetworkID id) noexcept;
-		static unsigned int GetList(unsigned int type, RakNet::NetworkID** data) noexcept;
+		static unsigned int GetList(unsigned int type, RakNet::NetworkID* data, unsigned int size) noexcept;
 		static unsigned int GetGameWeather() noexcept;
 		static signed long long GetGameTime() noexcept;
 		static unsigned int GetGameYear() noexcept;
@@ -275,12 +326,16 @@ class Script
 		static unsigned int GetReference(RakNet::NetworkID id) noexcept;
 		static unsigned int GetBase(RakNet::NetworkID id) noexcept;
 		static void GetPos(RakNet::NetworkID id, double* X, double* Y, double* Z) noexcept;
+		static unsigned int GetPosBatch(const RakNet::NetworkID* ids, unsigned int count, double* X, double* Y, double* Z) noexcept;
 		static void GetAngle(RakNet::NetworkID id, double* X, double* Y, double* Z) noexcept;
 		static unsigned int GetCell(RakNet::NetworkID id) noexcept;
+		static unsigned int GetCellBatch(const RakNet::NetworkID* ids, unsigned int count, unsigned int* cells) noexcept;
 		static unsigned int GetLock(RakNet::NetworkID id) noexcept;
 		static unsigned int GetOwner(RakNet::NetworkID id) noexcept;
 		static const char* GetBaseName(RakNet::NetworkID id) noexcept;
 		static bool IsNearPoint(RakNet::NetworkID id, double X, double Y, double Z, double R) noexcept;
+		static unsigned int GetObjectsInRadius(unsigned int cell, double X, double Y, double Z, double R, unsigned int type, RakNet::NetworkID* data, unsigned int size) noexcept;
+		static unsigned int GetObjectsInCell(unsigned int cell, unsigned int type, RakNet::NetworkID* data, unsigned int size) noexcept;
 		static RakNet::NetworkID GetItemContainer(RakNet::NetworkID id) noexcept;
 		static unsigned int GetItemCount(RakNet::NetworkID id) noexcept;
 		static double GetItemCondition(RakNet::NetworkID id) noexcept;
@@ -288,8 +343,9 @@ class Script
 		static bool GetItemSilent(RakNet::NetworkID id) noexcept;
 		static bool GetItemStick(RakNet::NetworkID id) noexcept;
 		static unsigned int GetContainerItemCount(RakNet::NetworkID id, unsigned int baseID) noexcept;
-		static unsigned int GetContainerItemList(RakNet::NetworkID id, RakNet::NetworkID** data) noexcept;
+		static unsigned int GetContainerItemList(RakNet::NetworkID id, RakNet::NetworkID* data, unsigned int size) noexcept;
 		static double GetActorValue(RakNet::NetworkID id, unsigned char index) noexcept;
+		static unsigned int GetActorValueBatch(const RakNet::NetworkID* ids, unsigned int count, unsigned char index, double* values) noexcept;
 		static double GetActorBaseValue(RakNet::NetworkID id, unsigned char index) noexcept;
 		static unsigned int GetActorIdleAnimation(RakNet::NetworkID id) noexcept;
 		static unsigned char GetActorMovingAnimation(RakNet::NetworkID id) noexcept;
@@ -304,7 +360,7 @@ class Script
 		static unsigned int GetPlayerSpawnCell(RakNet::NetworkID id) noexcept;
 		static bool GetPlayerConsoleEnabled(RakNet::NetworkID id) noexcept;
 		static unsigned int GetPlayerWindowCount(RakNet::NetworkID id) noexcept;
-		static unsigned int GetPlayerWindowList(RakNet::NetworkID id, RakNet::NetworkID** data) noexcept;
+		static unsigned int GetPlayerWindowList(RakNet::NetworkID id, RakNet::NetworkID* data, unsigned int size) noexcept;
 		static RakNet::NetworkID GetPlayerChatboxWindow(RakNet::NetworkID id) noexcept;
 
 		static RakNet::NetworkID CreateObject(unsigned int baseID, unsigned int cell, double X, double Y, double Z) noexcept;
@@ -355,7 +411,7 @@ class Script
 		static RakNet::NetworkID GetWindowParent(RakNet::NetworkID id) noexcept;
 		static RakNet::NetworkID GetWindowRoot(RakNet::NetworkID id) noexcept;
 		static unsigned int GetWindowChildCount(RakNet::NetworkID id) noexcept;
-		static unsigned int GetWindowChildList(RakNet::NetworkID id, RakNet::NetworkID** data) noexcept;
+		static unsigned int GetWindowChildList(RakNet::NetworkID id, RakNet::NetworkID* data, unsigned int size) noexcept;
 		static void GetWindowPos(RakNet::NetworkID id, double* X, double* Y, double* offset_X, double* offset_Y) noexcept;
 		static void GetWindowSize(RakNet::NetworkID id, double* X, double* Y, double* offset_X, double* offset_Y) noexcept;
 		static bool GetWindowVisible(RakNet::NetworkID id) noexcept;
@@ -368,9 +424,9 @@ class Script
 		static unsigned int GetRadioButtonGroup(RakNet::NetworkID id) noexcept;
 		static bool GetListMultiSelect(RakNet::NetworkID id) noexcept;
 		static unsigned int GetListItemCount(RakNet::NetworkID id) noexcept;
-		static unsigned int GetListItemList(RakNet::NetworkID id, RakNet::NetworkID** data) noexcept;
+		static unsigned int GetListItemList(RakNet::NetworkID id, RakNet::NetworkID* data, unsigned int size) noexcept;
 		static unsigned int GetListSelectedItemCount(RakNet::NetworkID id) noexcept;
-		static unsigned int GetListSelectedItemList(RakNet::NetworkID id, RakNet::NetworkID** data) noexcept;
+		static unsigned int GetListSelectedItemList(RakNet::NetworkID id, RakNet::NetworkID* data, unsigned int size) noexcept;
 		static RakNet::NetworkID GetListItemContainer(RakNet::NetworkID id) noexcept;
 		static bool GetListItemSelected(RakNet::NetworkID id) noexcept;
 		static const char* GetListItemText(RakNet::NetworkID id) noexcept;
@@ -428,6 +484,7 @@ class Script
 			{"ChatMessage", Script::ChatMessage},
 			{"SetRespawnTime", Player::SetRespawnTime},
 			{"SetSpawnCell", Script::SetSpawnCell},
+			{"LoadCell", Script::LoadCell},
 			{"SetConsoleEnabled", Player::SetConsoleEnabled},
 			{"SetGameWeather", Script::SetGameWeather},
 			{"SetGameTime", Script::SetGameTime},
@@ -474,12 +531,16 @@ class Script
 			{"GetReference", Script::GetReference},
 			{"GetBase", Script::GetBase},
 			{"GetPos", Script::GetPos},
+			{"GetPosBatch", Script::GetPosBatch},
 			{"GetAngle", Script::GetAngle},
 			{"GetCell", Script::GetCell},
+			{"GetCellBatch", Script::GetCellBatch},
 			{"GetLock", Script::GetLock},
 			{"GetOwner", Script::GetOwner},
 			{"GetBaseName", Script::GetBaseName},
 			{"IsNearPoint", Script::IsNearPoint},
+			{"GetObjectsInRadius", Script::GetObjectsInRadius},
+			{"GetObjectsInCell", Script::GetObjectsInCell},
 			{"GetItemContainer", Script::GetItemContainer},
 			{"GetItemCount", Script::GetItemCount},
 			{"GetItemCondition", Script::GetItemCondition},
@@ -489,6 +550,7 @@ class Script
 			{"GetContainerItemCount", Script::GetContainerItemCount},
 			{"GetContainerItemList", Script::GetContainerItemList},
 			{"GetActorValue", Script::GetActorValue},
+			{"GetActorValueBatch", Script::GetActorValueBatch},
 			{"GetActorBaseValue", Script::GetActorBaseValue},
 			{"GetActorIdleAnimation", Script::GetActorIdleAnimation},
 			{"GetActorMovingAnimation", Script::GetActorMovingAnimation},
@@ -635,6 +697,14 @@ class Script
 			{"OnServerExit", Function<void, bool>()},
 		};
 
+		static constexpr bool FNE(const char* a, const char* b) {
+			return *a == *b && (!*a || FNE(a + 1, b + 1));
+		}
+
+		static constexpr unsigned int FI(const char* name, const unsigned int N = 0) {
+			return FNE(functions[N].name, name) ? N : FI(name, N + 1);
+		}
+
 		static constexpr ScriptCallbackData const& CBD(const unsigned int I, const unsigned int N = 0) {
 			return callbacks[N].index == I ? callbacks[N] : CBD(I, N + 1);
 		}
@@ -675,6 +745,52 @@ class Script
 			return count;
 		}
 
+		/**
+		 * \brief Callbacks which are delivered through OnEventBatch, in order of EventType
+		 */
+		static constexpr unsigned int batched[] {
+			Utils::hash("OnActivate"),
+			Utils::hash("OnCellChange"),
+			Utils::hash("OnLockChange"),
+			Utils::hash("OnItemCountChange"),
+			Utils::hash("OnItemConditionChange"),
+			Utils::hash("OnItemEquippedChange"),
+			Utils::hash("OnActorValueChange"),
+			Utils::hash("OnActorBaseValueChange"),
+			Utils::hash("OnActorAlert"),
+			Utils::hash("OnActorSneak"),
+			Utils::hash("OnActorPunch"),
+			Utils::hash("OnActorFireWeapon"),
+		};
+
+		static constexpr unsigned int NO_EVENT = UINT_MAX;
+
+		static constexpr unsigned int EVI(const unsigned int I, const unsigned int N = 0) {
+			return N < std::extent<decltype(batched)>::value ? (batched[N] == I ? N : EVI(I, N + 1)) : NO_EVENT;
+		}
+
+		static void EventArg(ScriptEvent& event, RakNet::NetworkID other) noexcept { event.other = other; }
+		static void EventArg(ScriptEvent& event, unsigned int value) noexcept { event.value = value; }
+		static void EventArg(ScriptEvent& event, unsigned char value) noexcept { event.value = value; }
+		static void EventArg(ScriptEvent& event, bool value) noexcept { event.value = value; }
+		static void EventArg(ScriptEvent& event, double number) noexcept { event.number = number; }
+
+		template<unsigned int I, typename... Args>
+		static typename std::enable_if<EVI(I) == NO_EVENT, bool>::type Batch(Script*, Args&&...) noexcept { return false; }
+
+		template<unsigned int I, typename... Args>
+		static typename std::enable_if<EVI(I) != NO_EVENT, bool>::type Batch(Script* script, RakNet::NetworkID id, Args&&... args) {
+			if (!script->batch_)
+				return false;
+
+			ScriptEvent event{EVI(I), id, 0, 0, 0.0};
+			int expand[] = {0, (EventArg(event, args), 0)...};
+			static_cast<void>(expand);
+
+			script->events_.emplace_back(event);
+			return true;
+		}
+
 		template<unsigned int I, bool B = false, typename... Args>
 		static unsigned int Call(Args&&... args) {
 			constexpr ScriptCallbackData const& data = CBD(I);
@@ -684,6 +800,12 @@ class Script
 
 			for (auto& script : scripts)
 			{
+				if (Batch<I>(script.get(), args...))
+				{
+					++count;
+					continue;
+				}
+
 				if (!script->callbacks_.count(I))
 					script->callbacks_.emplace(I, script->GetScript<FunctionEllipsis<void>>(data.name));
 
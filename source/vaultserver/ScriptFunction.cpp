@@ -2,8 +2,115 @@
 #include "VaultException.hpp"
 #include "PAWN.hpp"
 
+#include <cstring>
+
 using namespace std;
 
+/**
+ * \brief The types a definition character is passed as
+ *
+ * Only the argument passing of the native calling convention matters, so kinds that are passed the same way share a type.
+ * This leaves two kinds on either architecture and bounds the trampolines to 2^MAX_ARGS signatures.
+ */
+struct ArgumentKinds
+{
+#if defined __x86_64__ || defined _M_X64
+	// every integer and pointer occupies a full register or stack slot, floating point values are passed separately
+	typedef unsigned long long Word;
+	typedef unsigned long long Long;
+	typedef double Float;
+
+	static Float AsFloat(double value) { return value; }
+#else
+	// every argument is pushed on the stack, a double takes the same two slots as a 64-bit integer with its bit pattern
+	typedef unsigned int Word;
+	typedef unsigned long long Long;
+	typedef unsigned long long Float;
+
+	static Float AsFloat(double value)
+	{
+		Float bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+#endif
+
+	static_assert(sizeof(Word) == sizeof(void*), "Word must be of pointer width");
+};
+
+/**
+ * \brief Gives a script function pointer the type it is called with
+ *
+ * The cast goes through void(*)(), which GCC takes as a generic function pointer and doesn't warn about.
+ */
+template<typename... Args>
+using TypedFunc = unsigned long long(*)(Args...);
+
+template<typename... Args>
+static TypedFunc<Args...> Typed(ScriptFunc fCpp)
+{
+	return reinterpret_cast<TypedFunc<Args...>>(reinterpret_cast<void(*)()>(fCpp));
+}
+
+/**
+ * \brief Calls a C++ script function through a function pointer typed after its definition string
+ *
+ * Every definition character is mapped to its argument kind, so each signature up to MAX_ARGS arguments is a
+ * plain call the compiler emits for the native calling convention.
+ */
+template<unsigned int N, typename... Args>
+struct Trampoline
+{
+	typedef ArgumentKinds::Word Word;
+	typedef ArgumentKinds::Long Long;
+	typedef ArgumentKinds::Float Float;
+
+	static unsigned long long Call(ScriptFunc fCpp, const char* def, vector<boost::any>::const_iterator arg, Args... values)
+	{
+		switch (*def)
+		{
+			case '\0':
+				return Typed<Args...>(fCpp)(values...);
+
+			case 'i':
+				return Trampoline<N - 1, Args..., Word>::Call(fCpp, def + 1, arg + 1, values..., boost::any_cast<unsigned int>(*arg));
+
+			case 'q':
+				return Trampoline<N - 1, Args..., Word>::Call(fCpp, def + 1, arg + 1, values..., static_cast<unsigned int>(boost::any_cast<signed int>(*arg)));
+
+			case 'l':
+				return Trampoline<N - 1, Args..., Long>::Call(fCpp, def + 1, arg + 1, values..., boost::any_cast<unsigned long long>(*arg));
+
+			case 'w':
+				return Trampoline<N - 1, Args..., Long>::Call(fCpp, def + 1, arg + 1, values..., boost::any_cast<signed long long>(*arg));
+
+			case 'f':
+				return Trampoline<N - 1, Args..., Float>::Call(fCpp, def + 1, arg + 1, values..., ArgumentKinds::AsFloat(boost::any_cast<double>(*arg)));
+
+			case 'p':
+				return Trampoline<N - 1, Args..., Word>::Call(fCpp, def + 1, arg + 1, values..., reinterpret_cast<Word>(boost::any_cast<void*>(*arg)));
+
+			case 's':
+				return Trampoline<N - 1, Args..., Word>::Call(fCpp, def + 1, arg + 1, values..., reinterpret_cast<Word>(boost::any_cast<string>(&*arg)->c_str()));
+
+			default:
+				throw VaultException("C++ call: Unknown argument identifier %02X", *def).stacktrace();
+		}
+	}
+};
+
+template<typename... Args>
+struct Trampoline<0, Args...>
+{
+	static unsigned long long Call(ScriptFunc fCpp, const char* def, vector<boost::any>::const_iterator, Args... values)
+	{
+		if (*def)
+			throw VaultException("C++ call: More than %u arguments are not supported", static_cast<unsigned int>(sizeof...(Args))).stacktrace();
+
+		return Typed<Args...>(fCpp)(values...);
+	}
+};
+
 ScriptFunction::ScriptFunction(ScriptFunc fCpp, const string& def) : fCpp(fCpp), def(def), pawn(false)
 {
 
@@ -22,109 +129,11 @@ ScriptFunction::~ScriptFunction()
 
 unsigned long long ScriptFunction::Call(const vector<boost::any>& args)
 {
-	unsigned long long result;
-
 	if (def.length() != args.size())
 		throw VaultException("Script call: Number of arguments does not match definition").stacktrace();
 
 	if (pawn)
-		result = PAWN::Call(fPawn.amx, fPawn.name.c_str(), def.c_str(), args);
-	else
-	{
-		// cdecl convention
-		string::iterator it;
-		vector<boost::any>::const_iterator it2;
-		vector<unsigned int> data;
-
-		for (it = def.begin(), it2 = args.begin(); it != def.end(); ++it, ++it2)
-		{
-			switch (*it)
-			{
-				case 'i':
-				{
-					unsigned int value = boost::any_cast<unsigned int>(*it2);
-					data.push_back(value);
-					break;
-				}
-
-				case 'q':
-				{
-					unsigned int value = boost::any_cast<signed int>(*it2);
-					data.push_back(value);
-					break;
-				}
-
-				case 'l':
-				{
-					unsigned long long value = boost::any_cast<unsigned long long>(*it2);
-					data.push_back(*reinterpret_cast<unsigned int*>(&value));
-					data.push_back(*reinterpret_cast<unsigned int*>((unsigned) &value + 4));
-					break;
-				}
-
-				case 'w':
-				{
-					signed long long value = boost::any_cast<signed long long>(*it2);
-					data.push_back(*reinterpret_cast<unsigned int*>(&value));
-					data.push_back(*reinterpret_cast<unsigned int*>((unsigned) &value + 4));
-					break;
-				}
-
-				case 'f':
-				{
-					double value = boost::any_cast<double>(*it2);
-					data.push_back(*reinterpret_cast<unsigned int*>(&value));
-					data.push_back(*reinterpret_cast<unsigned int*>((unsigned) &value + 4));
-					break;
-				}
-
-				case 'p':
-				{
-					void* value = boost::any_cast<void*>(*it2);
-					data.push_back(reinterpret_cast<unsigned int>(value));
-					break;
-				}
-
-				case 's':
-				{
-					const string* value = boost::any_cast<string>(&*it2);
-					data.push_back(reinterpret_cast<unsigned int>(value->c_str()));
-					break;
-				}
-
-				default:
-					throw VaultException("C++ call: Unknown argument identifier %02X", *it).stacktrace();
-			}
-		}
-
-		unsigned int low;
-		unsigned int high;
-		unsigned int* source = &data[0];
-		unsigned int size = data.size() * 4;
-
-		asm(
-			"MOV EDI,ESP\n"
-			"SUB EDI,%3\n"
-			"MOV ESI,%4\n"
-			"MOV ECX,%3\n"
-			"PUSH DS\n"
-			"POP ES\n"
-			"CLD\n"
-			"REP MOVSB\n"
-			"MOV ESI,ESP\n"
-			"SUB ESP,%3\n"
-			"CALL %2\n"
-			"MOV ESP,ESI\n"
-			"MOV %0,EAX\n"
-			"MOV %1,EDX\n"
-			: "=m"(low), "=m"(high)
-			: "m"(fCpp) , "m"(size), "m"(source)
-			: "eax", "edx", "ecx", "esi", "edi", "cc"
-		);
-
-		*reinterpret_cast<unsigned int*>(&result) = low;
-		*reinterpret_cast<unsigned int*>(((unsigned) &result) + 4) = high;
-	}
+		return PAWN::Call(fPawn.amx, fPawn.name.c_str(), def.c_str(), args);
 
-	return result;
+	return Trampoline<MAX_ARGS>::Call(fCpp, def.c_str(), args.begin());
 }
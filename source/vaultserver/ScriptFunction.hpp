@@ -5,6 +5,9 @@
 #include "amx/amx.h"
 #include "boost/any.hpp"
 
+#include <string>
+#include <vector>
+
 typedef unsigned long long(*ScriptFunc)();
 typedef std::string ScriptFuncPAWN;
 
@@ -20,6 +23,10 @@ class ScriptFunction
 			} fPawn;
 		};
 
+	public:
+		// C++ timers and publics can take at most this many arguments, vaultscript.h checks it when they are created
+		static constexpr unsigned int MAX_ARGS = 8;
+
 	protected:
 		std::string def;
 		bool pawn;
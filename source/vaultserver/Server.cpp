@@ -113,14 +113,9 @@ NetworkResponse Server::NewPlayer(RakNetGUID guid, NetworkID id)
 	Script::Call<Script::CBI("OnPlayerRequestGame")>(result, id);
 
 	auto player_name = GameFactory::Operate<Player>(id, [&response, guid, id, client, &result](Player* player) {
-		auto baseIDs = Player::GetBaseIDs();
-
 		// TODO hardcoded hack to not get DLC bases, no proper mod handling yet
 		if (!result)
-			result = DB::NPC::GetNPC([&baseIDs](const DB::NPC& data)
-			{
-				return find(baseIDs.begin(), baseIDs.end(), data.GetBase()) == baseIDs.end() && (!(data.GetBase() & 0xFF000000) && !data.IsEssential() && !DB::Race::Lookup(data.GetRace())->IsChild());
-			})->GetBase();
+			result = DB::NPC::GetNPC(0x00000000, DB::NPC::Essential | DB::NPC::Child | DB::NPC::DLC)->GetBase();
 
 		const auto* npc = *DB::NPC::Lookup(result);
 
@@ -170,6 +165,9 @@ NetworkResponse Server::NewPlayer(RakNetGUID guid, NetworkID id)
 		return player->GetName();
 	});
 
+	// the spawn context is sent with the references below, other clients get it right away
+	Script::LoadCells(Player::GetSpawnCell(), client);
+
 	GameFactory::Operate<Reference, EXCEPTION_FACTORY_VALIDATED>(GameFactory::GetByType(ALL_REFERENCES), [&response, guid, id](FactoryReferences& references) {
 		partition(references.begin(), references.end(), [](FactoryReference& reference) { return reference->IsPersistent() && reference->GetReference() != PLAYER_REFERENCE; });
 
@@ -253,6 +251,7 @@ NetworkResponse Server::GetPos(RakNetGUID guid, FactoryObject& reference, float
 			});
 
 			GameFactory::Free(reference);
+			Script::LoadCells(cell);
 			Script::Call<Script::CBI("OnCellChange")>(id, cell);
 		}
 		else
@@ -301,6 +300,7 @@ NetworkResponse Server::GetCell(RakNetGUID guid, FactoryObject& reference, unsig
 		});
 
 		GameFactory::Free(reference);
+		Script::LoadCells(cell);
 		Script::Call<Script::CBI("OnCellChange")>(id, cell);
 	}
 
@@ -314,7 +314,7 @@ NetworkResponse Server::GetActivate(RakNetGUID guid, FactoryReference& reference
 	NetworkID reference_id = reference->GetNetworkID();
 	NetworkID actor_id = actor->GetNetworkID();
 
-	if (reference->IsPersistent() && !DB::Reference::Lookup(reference->GetReference())->GetType().compare("DOOR"))
+	if (reference->IsPersistent() && DB::Reference::Lookup(reference->GetReference())->GetTypeCode() == DB::Record::FourCC("DOOR"))
 		response.emplace_back(
 			PacketFactory::Create<pTypes::ID_UPDATE_ACTIVATE>(reference_id, actor_id),
 			HIGH_PRIORITY, RELIABLE_ORDERED, CHANNEL_GAME, guid);
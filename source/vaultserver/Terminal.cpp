@@ -1,30 +1,30 @@
 #include "Terminal.hpp"
 #include "API.hpp"
-#include "sqlite/sqlite3.h"
+#include "Database.hpp"
 
 using namespace std;
 using namespace DB;
 using namespace Values;
 
-unordered_map<unsigned int, Terminal*> Terminal::terminals;
+FlatIndex<Terminal*> Terminal::terminals;
 
-Terminal::Terminal(const string& table, sqlite3_stmt* stmt)
+Terminal::Terminal(const string& table, const DatabaseRow& row)
 {
-	if (sqlite3_column_count(stmt) != 4)
+	if (row.GetColumnCount() != 4)
 		throw VaultException("Malformed input database (terminals): %s", table.c_str()).stacktrace();
 
-	unsigned int dlc = static_cast<unsigned int>(sqlite3_column_int(stmt, 3));
+	unsigned int dlc = static_cast<unsigned int>(row.GetInt(3));
 	// if DLC enabled
 
 	dlc <<= 24;
 
-	baseID = static_cast<unsigned int>(sqlite3_column_int(stmt, 0));
-	lock = static_cast<unsigned int>(sqlite3_column_int(stmt, 1));
+	baseID = static_cast<unsigned int>(row.GetInt(0));
+	lock = static_cast<unsigned int>(row.GetInt(1));
 
 	if (lock == UINT_MAX - 1) // -2
 		lock = Lock_Unlocked;
 
-	note = static_cast<unsigned int>(sqlite3_column_int(stmt, 2));
+	note = static_cast<unsigned int>(row.GetInt(2));
 
 	if (note & 0xFF000000)
 	{
@@ -36,19 +36,18 @@ Terminal::Terminal(const string& table, sqlite3_stmt* stmt)
 	{
 		baseID &= 0x00FFFFFF;
 		baseID |= dlc;
+		terminals.Insert(baseID, this);
 	}
 	else
-		terminals.erase(baseID);
-
-	terminals.emplace(baseID, this);
+		terminals.Assign(baseID, this);
 }
 
 Expected<Terminal*> Terminal::Lookup(unsigned int baseID)
 {
-	auto it = terminals.find(baseID);
+	auto terminal = terminals.Find(baseID);
 
-	if (it != terminals.end())
-		return it->second;
+	if (terminal)
+		return *terminal;
 
 	return VaultException("No terminal with baseID %08X found", baseID);
 }
@@ -3,10 +3,9 @@
 
 #include "vaultserver.hpp"
 #include "Expected.hpp"
+#include "FlatIndex.hpp"
 
-#include <unordered_map>
-
-class sqlite3_stmt;
+class DatabaseRow;
 
 /**
  * \brief Represents a terminal
@@ -17,7 +16,7 @@ namespace DB
 	class Terminal
 	{
 		private:
-			static std::unordered_map<unsigned int, Terminal*> terminals;
+			static FlatIndex<Terminal*> terminals;
 
 			unsigned int baseID;
 			unsigned int lock;
@@ -33,7 +32,7 @@ namespace DB
 			unsigned int GetLock() const;
 			unsigned int GetNote() const;
 
-			Terminal(const std::string& table, sqlite3_stmt* stmt);
+			Terminal(const std::string& table, const DatabaseRow& row);
 			~Terminal() = default;
 			// must never be called. only defined because vector requires it
 			Terminal(Terminal&&) { std::terminate(); }
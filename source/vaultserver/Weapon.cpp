@@ -1,27 +1,27 @@
 #include "Weapon.hpp"
-#include "sqlite/sqlite3.h"
+#include "Database.hpp"
 
 using namespace std;
 using namespace DB;
 
-unordered_map<unsigned int, Weapon*> Weapon::weapons;
+FlatIndex<Weapon*> Weapon::weapons;
 
-Weapon::Weapon(const string& table, sqlite3_stmt* stmt)
+Weapon::Weapon(const string& table, const DatabaseRow& row)
 {
-	if (sqlite3_column_count(stmt) != 7)
+	if (row.GetColumnCount() != 7)
 		throw VaultException("Malformed input database (weapons): %s", table.c_str()).stacktrace();
 
-	unsigned int dlc = static_cast<unsigned int>(sqlite3_column_int(stmt, 6));
+	unsigned int dlc = static_cast<unsigned int>(row.GetInt(6));
 	// if DLC enabled
 
 	dlc <<= 24;
 
-	baseID = static_cast<unsigned int>(sqlite3_column_int(stmt, 0));
-	damage = sqlite3_column_double(stmt, 1);
-	reload = sqlite3_column_double(stmt, 2);
-	rate = sqlite3_column_double(stmt, 3);
-	automatic = static_cast<bool>(sqlite3_column_int(stmt, 4));
-	ammo = sqlite3_column_double(stmt, 5);
+	baseID = static_cast<unsigned int>(row.GetInt(0));
+	damage = row.GetDouble(1);
+	reload = row.GetDouble(2);
+	rate = row.GetDouble(3);
+	automatic = static_cast<bool>(row.GetInt(4));
+	ammo = row.GetDouble(5);
 
 	if (ammo & 0xFF000000)
 	{
@@ -33,19 +33,18 @@ Weapon::Weapon(const string& table, sqlite3_stmt* stmt)
 	{
 		baseID &= 0x00FFFFFF;
 		baseID |= dlc;
+		weapons.Insert(baseID, this);
 	}
 	else
-		weapons.erase(baseID);
-
-	weapons.emplace(baseID, this);
+		weapons.Assign(baseID, this);
 }
 
 Expected<Weapon*> Weapon::Lookup(unsigned int baseID)
 {
-	auto it = weapons.find(baseID);
+	auto weapon = weapons.Find(baseID);
 
-	if (it != weapons.end())
-		return it->second;
+	if (weapon)
+		return *weapon;
 
 	return VaultException("No weapon with baseID %08X found", baseID);
 }
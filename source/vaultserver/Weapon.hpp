@@ -1,16 +1,15 @@
 #ifndef WEAPONDB_H
 #define WEAPONDB_H
 
-#include <unordered_map>
-
 #include "vaultmp.hpp"
 #include "vaultserver.hpp"
 #include "Database.hpp"
 #include "Expected.hpp"
+#include "FlatIndex.hpp"
 
 #include "vaultserver.hpp"
 
-class sqlite3_stmt;
+class DatabaseRow;
 
 /**
  * \brief Represents a game weapon
@@ -21,7 +20,7 @@ namespace DB
 	class Weapon
 	{
 		private:
-			static std::unordered_map<unsigned int, Weapon*> weapons;
+			static FlatIndex<Weapon*> weapons;
 
 			unsigned int baseID;
 			float damage;
@@ -43,7 +42,7 @@ namespace DB
 			bool IsAutomatic() const;
 			unsigned int GetAmmo() const;
 
-			Weapon(const std::string& table, sqlite3_stmt* stmt);
+			Weapon(const std::string& table, const DatabaseRow& row);
 			~Weapon() = default;
 			// must never be called. only defined because vector requires it
 			Weapon(Weapon&&) { std::terminate(); }
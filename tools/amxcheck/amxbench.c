@@ -0,0 +1,90 @@
+/*
+ * Times a compiled PAWN script on the abstract machine it is linked against by running
+ * every public of it the given number of rounds, natives return 0 without doing work.
+ *
+ * Build it once with the ANSI C core and once with the GCC computed goto core
+ * (see makefile.unix) and compare the times of both on the same script.
+ */
+
+#include "amx/amx.h"
+#include "amx/amxaux.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+static cell AMX_NATIVE_CALL stub(AMX* amx, const cell* params)
+{
+	(void) amx;
+	(void) params;
+	return 0;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+int main(int argc, char* argv[])
+{
+	AMX amx;
+	int err, count;
+	unsigned long rounds;
+
+	if (argc != 3)
+	{
+		fprintf(stderr, "usage: %s script.amx rounds\n", argv[0]);
+		return 1;
+	}
+
+	rounds = strtoul(argv[2], NULL, 10);
+
+	if ((err = aux_LoadProgram(&amx, argv[1], NULL)) != AMX_ERR_NONE)
+	{
+		fprintf(stderr, "could not load %s: %s\n", argv[1], aux_StrError(err));
+		return 1;
+	}
+
+	amx_NumNatives(&amx, &count);
+
+	for (int i = 0; i < count; ++i)
+	{
+		AMX_NATIVE_INFO native[2] = {{NULL, stub}, {NULL, NULL}};
+		char name[sNAMEMAX + 1];
+		amx_GetNative(&amx, i, name);
+		native[0].name = name;
+		amx_Register(&amx, native, 1);
+	}
+
+	amx_NumPublics(&amx, &count);
+
+	unsigned long calls = 0;
+	double start = now();
+
+	for (unsigned long round = 0; round < rounds; ++round)
+		for (int i = 0; i < count; ++i)
+		{
+			/* the same arguments for every public, unused ones are ignored by the callee */
+			for (int arg = 4; arg > 0; --arg)
+				amx_Push(&amx, arg);
+
+			cell retval = 0;
+
+			if ((err = amx_Exec(&amx, &retval, i)) != AMX_ERR_NONE)
+			{
+				fprintf(stderr, "public %d failed: %s\n", i, aux_StrError(err));
+				return 1;
+			}
+
+			++calls;
+		}
+
+	double ms = now() - start;
+	printf("%lu publics in %.1f ms, %.1f ns per public\n", calls, ms, calls ? ms * 1000000.0 / calls : 0.0);
+
+	aux_FreeProgram(&amx);
+	return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * Runs a compiled PAWN script on the abstract machine it is linked against and
+ * prints a trace of every native call and of the data segment after each public.
+ *
+ * Build it once with the ANSI C core and once with the GCC computed goto core
+ * (see makefile.unix), run both on the same script and compare the traces.
+ */
+
+#include "amx/amx.h"
+#include "amx/amxaux.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+static unsigned int fnv(const unsigned char* data, size_t size)
+{
+	unsigned int hash = 2166136261u;
+
+	for (size_t i = 0; i < size; ++i)
+		hash = (hash ^ data[i]) * 16777619u;
+
+	return hash;
+}
+
+static cell AMX_NATIVE_CALL stub(AMX* amx, const cell* params)
+{
+	(void) amx;
+	(void) params;
+	return 0;
+}
+
+/* every native is routed through here, the result is derived from the arguments so that the script sees varying values */
+static int AMXAPI callback(AMX* amx, cell index, cell* result, const cell* params)
+{
+	char name[sNAMEMAX + 1];
+	cell count = params[0] / (cell) sizeof(cell);
+	cell value = index;
+
+	amx_GetNative(amx, (int) index, name);
+	printf("native %s(", name);
+
+	AMX_HEADER* hdr = (AMX_HEADER*) amx->base;
+	unsigned char* data = amx->data ? amx->data : amx->base + hdr->dat;
+
+	for (cell i = 1; i <= count; ++i)
+	{
+		/* the cores may pass physical addresses, print those relative to the data segment so that traces compare */
+		cell arg = params[i];
+		int address = (ucell) arg >= (ucell) data && (ucell) arg < (ucell) data + (ucell) hdr->stp;
+
+		if (address)
+			arg -= (cell) data;
+
+		printf(i > 1 ? (address ? ", @%lld" : ", %lld") : (address ? "@%lld" : "%lld"), (long long) arg);
+		value = value * 31 + arg;
+	}
+
+	printf(") = %lld\n", (long long) value);
+	*result = value;
+	return AMX_ERR_NONE;
+}
+
+static void dump(AMX* amx, const char* name, int err, cell retval)
+{
+	AMX_HEADER* hdr = (AMX_HEADER*) amx->base;
+	unsigned char* data = amx->data ? amx->data : amx->base + hdr->dat;
+
+	printf("public %s: error %d, result %lld, data %08X\n", name, err, (long long) retval, fnv(data, (size_t) (hdr->hea - hdr->dat)));
+}
+
+int main(int argc, char* argv[])
+{
+	AMX amx;
+	int err, count;
+
+	if (argc != 2)
+	{
+		fprintf(stderr, "usage: %s script.amx\n", argv[0]);
+		return 1;
+	}
+
+	if ((err = aux_LoadProgram(&amx, argv[1], NULL)) != AMX_ERR_NONE)
+	{
+		fprintf(stderr, "could not load %s: %s\n", argv[1], aux_StrError(err));
+		return 1;
+	}
+
+	amx_NumNatives(&amx, &count);
+
+	for (int i = 0; i < count; ++i)
+	{
+		AMX_NATIVE_INFO native[2] = {{NULL, stub}, {NULL, NULL}};
+		char name[sNAMEMAX + 1];
+		amx_GetNative(&amx, i, name);
+		native[0].name = name;
+		amx_Register(&amx, native, 1);
+	}
+
+	amx_SetCallback(&amx, callback);
+
+	cell retval = 0;
+	err = amx_Exec(&amx, &retval, AMX_EXEC_MAIN);
+	dump(&amx, "main", err, retval);
+
+	amx_NumPublics(&amx, &count);
+
+	for (int i = 0; i < count; ++i)
+	{
+		char name[sNAMEMAX + 1];
+		amx_GetPublic(&amx, i, name, NULL);
+
+		/* the same arguments for every public, unused ones are ignored by the callee */
+		for (int arg = 4; arg > 0; --arg)
+			amx_Push(&amx, arg);
+
+		retval = 0;
+		err = amx_Exec(&amx, &retval, i);
+		dump(&amx, name, err, retval);
+	}
+
+	aux_FreeProgram(&amx);
+	return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * Measures the calls of C++ timers and publics through ScriptFunction's trampolines against direct calls.
+ *
+ * usage: callbench [calls]
+ *
+ * ScriptFunction.cpp is linked as the server builds it. The inline assembly it replaced copied the arguments onto the
+ * i386 stack and can't be built for x86-64, the direct call is the lower bound the trampolines are measured against.
+ * The script functions live in this file but are called through function pointers, as they are from a script library.
+ */
+
+#include "ScriptFunction.hpp"
+#include "PAWN.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+
+using namespace std;
+
+// ScriptFunction.cpp hands PAWN functions to PAWN::Call, which needs the whole server, C++ functions never get there
+cell PAWN::Call(AMX*, const char*, const char*, const vector<boost::any>&)
+{
+	abort();
+}
+
+class Function : public ScriptFunction
+{
+	public:
+		Function(ScriptFunc fCpp, const string& def) : ScriptFunction(fCpp, def) {}
+
+		using ScriptFunction::Call;
+};
+
+static unsigned long long sum = 0;
+
+extern "C" {
+	__attribute__((noinline)) unsigned long long None() { return ++sum; }
+	__attribute__((noinline)) unsigned long long Id(unsigned long long id) { return sum += id; }
+	__attribute__((noinline)) unsigned long long IdValue(unsigned long long id, unsigned int index, double value) { return sum += id + index + static_cast<unsigned long long>(value); }
+	__attribute__((noinline)) unsigned long long String(unsigned long long id, const char* str) { return sum += id + str[0]; }
+	__attribute__((noinline)) unsigned long long Eight(unsigned long long a, unsigned int b, double c, const char* d, unsigned long long e, signed int f, double g, unsigned long long h) { return sum += a + b + static_cast<unsigned long long>(c) + d[0] + e + f + static_cast<unsigned long long>(g) + h; }
+}
+
+// direct calls the script function through a volatile pointer, so it stays an indirect call as well
+template<typename F>
+static void Compare(const char* def, void(*function)(), const vector<boost::any>& args, unsigned int calls, F direct)
+{
+	Function trampoline(reinterpret_cast<ScriptFunc>(function), def);
+
+	sum = 0;
+	auto start = chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < calls; ++i)
+		direct();
+
+	double direct_ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / calls;
+	unsigned long long direct_sum = sum;
+
+	sum = 0;
+	start = chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < calls; ++i)
+		trampoline.Call(args);
+
+	double called_ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / calls;
+
+	printf("%-10s %12.2f %12.2f %12.2f %s\n", def[0] ? def : "(none)", direct_ns, called_ns, called_ns - direct_ns, direct_sum == sum ? "" : "RESULTS DIFFER");
+}
+
+template<typename F>
+static void(*Generic(F function))()
+{
+	return reinterpret_cast<void(*)()>(function);
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int calls = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+	string str = "string";
+
+	printf("%u calls each, ns per call\n", calls);
+	printf("%-10s %12s %12s %12s\n", "", "direct", "ScriptFunc", "overhead");
+
+	const unsigned long long id = 0x0100000000000001ull;
+	auto volatile none = None;
+	auto volatile id_ = Id;
+	auto volatile id_value = IdValue;
+	auto volatile string_ = String;
+	auto volatile eight = Eight;
+
+	Compare("", Generic(None), {}, calls, [none]() { none(); });
+	Compare("l", Generic(Id), {id}, calls, [id, id_]() { id_(id); });
+	Compare("lif", Generic(IdValue), {id, 25u, 100.0}, calls, [id, id_value]() { id_value(id, 25u, 100.0); });
+	Compare("ls", Generic(String), {id, str}, calls, [id, string_, &str]() { string_(id, str.c_str()); });
+	Compare("lifslqfl", Generic(Eight), {id, 25u, 100.0, str, 2ull, -3, 4.0, 5ull}, calls, [id, eight, &str]() { eight(id, 25u, 100.0, str.c_str(), 2ull, -3, 4.0, 5ull); });
+
+	return 0;
+}
@@ -0,0 +1,289 @@
+/*
+ * Compares reading the game database through SQLite3 with reading its database image.
+ *
+ * usage: dbbench generate <database> [scale]   creates a synthetic database with the server's tables
+ *        dbbench sqlite <database>             reads it like Database<T>::initialize reads the database
+ *        dbbench image <image>                 reads it like Database<T>::initialize reads an image
+ *
+ * Both readers load the same table groups on one thread each, as GameFactory::Initialize does, and read
+ * every column once, copying text like the record constructors do. Run each mode in its own process,
+ * the RSS printed at the end is the one of the whole process.
+ */
+
+#include "DatabaseImage.hpp"
+
+#include <sqlite3.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <future>
+#include <chrono>
+#include <fstream>
+#include <tuple>
+#include <set>
+
+using namespace std;
+
+static const vector<vector<string>> loads = {
+	{"CONT", "NPC_", "CREA", "LVLI", "ALCH", "AMMO", "ARMA", "ARMO", "BOOK", "ENCH", "KEYM", "MISC", "NOTE", "WEAP", "CELL", "IDLE", "WTHR", "STAT", "MSTT", "RACE", "LIGH", "DOOR", "TERM", "EXPL", "PROJ", "STAT", "SOUN"},
+	{"exteriors"}, {"weapons"}, {"races"}, {"npcs"}, {"npcitems", "contitems"}, {"items"}, {"terminals"}, {"interiors"}, {"arefs", "crefs"},
+	{"refs_CONT", "refs_DOOR", "refs_TERM", "refs_STAT"},
+};
+
+static const char* RECORD = "(baseID integer, name varchar(128), description varchar(128), dlc integer)";
+static const char* REFERENCE = "(editor varchar(128), refID integer, baseID integer, count integer, health float, cell integer, x float, y float, z float, ax float, ay float, az float, flags integer, lock integer, key integer, link integer, dlc integer)";
+static const char* ACREFERENCE = "(editor varchar(128), refID integer, baseID integer, cell integer, x float, y float, z float, ax float, ay float, az float, flags integer, dlc integer)";
+static const char* CONTAINER = "(baseID integer, item integer, count integer, condition float, dlc integer)";
+
+// schemas as created by the scripts in other/, and row counts at scale 1
+static const vector<tuple<string, const char*, unsigned int>> schema = {
+	make_tuple("exteriors", "(baseID integer, x integer, y integer, wrld integer, dlc integer)", 12000),
+	make_tuple("weapons", "(baseID integer, damage float, reload float, rate float, automatic integer, ammo integer, dlc integer)", 300),
+	make_tuple("races", "(baseID integer, child integer, younger integer, older integer, dlc integer)", 40),
+	make_tuple("npcs", "(baseID integer, essential integer, female integer, race integer, template integer, flags integer, deathitem integer, dlc integer)", 2500),
+	make_tuple("npcitems", CONTAINER, 15000),
+	make_tuple("contitems", CONTAINER, 20000),
+	make_tuple("items", "(baseID integer, value integer, health integer, weight float, slot integer, dlc integer)", 3000),
+	make_tuple("terminals", "(baseID integer, lock integer, note integer, dlc integer)", 1500),
+	make_tuple("interiors", "(baseID integer, x1 integer, y1 integer, z1 integer, x2 integer, y2 integer, z2 integer, dlc integer)", 1200),
+	make_tuple("arefs", ACREFERENCE, 8000),
+	make_tuple("crefs", ACREFERENCE, 4000),
+	make_tuple("refs_CONT", REFERENCE, 8000),
+	make_tuple("refs_DOOR", REFERENCE, 6000),
+	make_tuple("refs_TERM", REFERENCE, 1500),
+	make_tuple("refs_STAT", REFERENCE, 50000),
+};
+
+static void Generate(const char* file, unsigned int scale)
+{
+	sqlite3* db;
+	remove(file);
+
+	if (sqlite3_open(file, &db) != SQLITE_OK)
+	{
+		fprintf(stderr, "Could not create %s\n", file);
+		exit(1);
+	}
+
+	sqlite3_exec(db, "PRAGMA synchronous = OFF; BEGIN", nullptr, nullptr, nullptr);
+
+	auto fill = [db, scale](const string& table, const char* columns, unsigned int rows) {
+		string create = "CREATE TABLE \"" + table + "\" " + columns;
+		sqlite3_exec(db, create.c_str(), nullptr, nullptr, nullptr);
+
+		sqlite3_stmt* stmt;
+		string select = "SELECT * FROM \"" + table + "\"";
+		sqlite3_prepare_v2(db, select.c_str(), -1, &stmt, nullptr);
+		int count = sqlite3_column_count(stmt);
+		sqlite3_finalize(stmt);
+
+		string insert = "INSERT INTO \"" + table + "\" VALUES (?";
+
+		for (int i = 1; i < count; ++i)
+			insert += ", ?";
+
+		insert += ")";
+		sqlite3_prepare_v2(db, insert.c_str(), -1, &stmt, nullptr);
+
+		for (unsigned int row = 0; row < rows * scale; ++row)
+		{
+			string definitions = columns;
+			size_t pos = 1;
+
+			for (int column = 0; column < count; ++column)
+			{
+				size_t end = definitions.find_first_of(",)", pos);
+				string definition = definitions.substr(pos, end - pos);
+				pos = end + 1;
+
+				if (definition.find("varchar") != string::npos)
+				{
+					char text[64];
+					snprintf(text, sizeof(text), "%s%05u", table.c_str(), (row * 7919u + column) % 50000u);
+					sqlite3_bind_text(stmt, column + 1, text, -1, SQLITE_TRANSIENT);
+				}
+				else if (definition.find("float") != string::npos)
+					sqlite3_bind_double(stmt, column + 1, (row * 31u + column) * 0.25);
+				else
+					sqlite3_bind_int(stmt, column + 1, column ? (row * 13u + column) % 100000u : 0x00010000u + row);
+			}
+
+			sqlite3_step(stmt);
+			sqlite3_reset(stmt);
+		}
+
+		sqlite3_finalize(stmt);
+	};
+
+	// the record tables list STAT twice, like GameFactory does
+	set<string> records(loads[0].begin(), loads[0].end());
+
+	for (const auto& table : records)
+		fill(table, RECORD, 1500);
+
+	for (const auto& table : schema)
+		fill(get<0>(table), get<1>(table), get<2>(table));
+
+	sqlite3_exec(db, "COMMIT", nullptr, nullptr, nullptr);
+	sqlite3_close(db);
+}
+
+struct Sink
+{
+	unsigned long long rows = 0;
+	unsigned long long sum = 0;
+	vector<string> texts;
+
+	void Text(const char* text)
+	{
+		texts.emplace_back(text ? text : "");
+		sum += texts.back().size();
+	}
+};
+
+static void ReadSQLite(const char* file, const vector<string>& tables, Sink& sink)
+{
+	sqlite3* db;
+	sqlite3_open_v2(file, &db, SQLITE_OPEN_READONLY, nullptr);
+
+	string query = "SELECT (0) ";
+
+	for (const string& table : tables)
+		query += "+ (SELECT COUNT(*) FROM " + table + ")";
+
+	sqlite3_stmt* stmt;
+	sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr);
+	sqlite3_step(stmt);
+	sink.texts.reserve(sqlite3_column_int(stmt, 0));
+	sqlite3_finalize(stmt);
+
+	for (const string& table : tables)
+	{
+		query = "SELECT * FROM " + table;
+		sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr);
+		int columns = sqlite3_column_count(stmt);
+
+		while (sqlite3_step(stmt) == SQLITE_ROW)
+		{
+			for (int i = 0; i < columns; ++i)
+				switch (sqlite3_column_type(stmt, i))
+				{
+					case SQLITE_TEXT:
+						sink.Text(reinterpret_cast<const char*>(sqlite3_column_text(stmt, i)));
+						break;
+
+					case SQLITE_FLOAT:
+						sink.sum += static_cast<unsigned long long>(sqlite3_column_double(stmt, i));
+						break;
+
+					default:
+						sink.sum += sqlite3_column_int(stmt, i);
+				}
+
+			++sink.rows;
+		}
+
+		sqlite3_finalize(stmt);
+	}
+
+	sqlite3_close(db);
+}
+
+static void ReadImage(const char* file, const vector<string>& tables, Sink& sink)
+{
+	DatabaseImage image(file);
+	unsigned int count = 0;
+
+	for (const string& table : tables)
+		count += image.GetTable(table)->rows;
+
+	sink.texts.reserve(count);
+
+	for (const string& name : tables)
+	{
+		const DatabaseImage::Table* table = image.GetTable(name);
+		const DatabaseImage::Type* types = image.GetTypes(table);
+
+		for (unsigned int row = 0; row < table->rows; ++row)
+		{
+			const DatabaseImage::Cell* cells = image.GetRow(table, row);
+
+			for (unsigned int i = 0; i < table->columns; ++i)
+				switch (types[i])
+				{
+					case DatabaseImage::Text:
+						sink.Text(image.GetString(cells[i].text));
+						break;
+
+					case DatabaseImage::Real:
+						sink.sum += static_cast<unsigned long long>(cells[i].real);
+						break;
+
+					default:
+						sink.sum += static_cast<signed int>(cells[i].integer);
+				}
+
+			++sink.rows;
+		}
+	}
+}
+
+static unsigned int Status(const char* field)
+{
+	ifstream status("/proc/self/status");
+	string line;
+
+	while (getline(status, line))
+		if (!line.compare(0, strlen(field), field))
+			return strtoul(line.c_str() + strlen(field), nullptr, 10);
+
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		fprintf(stderr, "usage: %s generate <database> [scale] | sqlite <database> | image <image>\n", argv[0]);
+		return 1;
+	}
+
+	string mode = argv[1];
+
+	if (mode == "generate")
+	{
+		Generate(argv[2], argc > 3 ? atoi(argv[3]) : 1);
+		return 0;
+	}
+
+	auto start = chrono::steady_clock::now();
+	vector<Sink> sinks(loads.size());
+	vector<future<void>> threads;
+
+	for (size_t i = 0; i < loads.size(); ++i)
+		threads.emplace_back(async(launch::async, [&mode, &sinks, argv, i]() {
+			if (mode == "sqlite")
+				ReadSQLite(argv[2], loads[i], sinks[i]);
+			else
+				ReadImage(argv[2], loads[i], sinks[i]);
+		}));
+
+	for (auto& thread : threads)
+		thread.get();
+
+	double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	unsigned long long rows = 0, sum = 0;
+
+	for (const auto& sink : sinks)
+	{
+		rows += sink.rows;
+		sum += sink.sum;
+	}
+
+	// the image is unmapped by now, the RSS left is what the loaded data costs
+	printf("%s: %llu rows in %.1f ms, checksum %llu, peak RSS %u kB, RSS after load %u kB\n", mode.c_str(), rows, ms, sum, Status("VmHWM:"), Status("VmRSS:"));
+	return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ * Compiles a vaultmp SQLite3 database into a database image the dedicated server maps at startup
+ * instead of reading the database (see source/vaultserver/DatabaseImage.hpp for the format).
+ *
+ * usage: dbimage <database> [image]
+ *
+ * The image defaults to the database name with the extension replaced by .vmdb, next to the database.
+ * It stores the size and modification time of the database, the server ignores an image whose database changed.
+ */
+
+#include "DatabaseImage.hpp"
+
+#include <sqlite3.h>
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+struct Column
+{
+	int type;
+	long long integer;
+	double real;
+	string text;
+};
+
+static vector<char> image;
+static vector<char> pool(1, '\0');
+static unordered_map<string, uint64_t> strings;
+
+static uint64_t Intern(const string& str)
+{
+	if (str.empty())
+		return 0;
+
+	auto it = strings.find(str);
+
+	if (it != strings.end())
+		return it->second;
+
+	uint64_t offset = pool.size();
+	pool.insert(pool.end(), str.begin(), str.end());
+	pool.emplace_back('\0');
+	strings.emplace(str, offset);
+	return offset;
+}
+
+static uint64_t Append(const void* data, size_t size)
+{
+	uint64_t offset = image.size();
+	image.insert(image.end(), static_cast<const char*>(data), static_cast<const char*>(data) + size);
+	image.resize((image.size() + 7) & ~static_cast<size_t>(7), '\0');
+	return offset;
+}
+
+static bool Compile(sqlite3* db, const string& name, DatabaseImage::Table& table)
+{
+	sqlite3_stmt* stmt;
+	string query = "SELECT * FROM \"" + name + "\"";
+
+	if (sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+	{
+		fprintf(stderr, "Could not prepare query: %s\n", sqlite3_errmsg(db));
+		return false;
+	}
+
+	unsigned int columns = sqlite3_column_count(stmt);
+	vector<Column> rows;
+	int ret;
+
+	while ((ret = sqlite3_step(stmt)) == SQLITE_ROW)
+		for (unsigned int i = 0; i < columns; ++i)
+		{
+			const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
+			rows.push_back(Column{sqlite3_column_type(stmt, i), sqlite3_column_int64(stmt, i), sqlite3_column_double(stmt, i), text ? text : ""});
+		}
+
+	sqlite3_finalize(stmt);
+
+	if (ret != SQLITE_DONE)
+	{
+		fprintf(stderr, "Failed processing query: %s\n", sqlite3_errmsg(db));
+		return false;
+	}
+
+	// a column is text if any value is, else real if any value is, NULL reads as 0 like it does from SQLite
+	vector<DatabaseImage::Type> types(columns, DatabaseImage::Integer);
+
+	for (size_t i = 0; i < rows.size(); ++i)
+	{
+		DatabaseImage::Type& type = types[i % columns];
+
+		if (rows[i].type == SQLITE_TEXT || rows[i].type == SQLITE_BLOB)
+			type = DatabaseImage::Text;
+		else if (rows[i].type == SQLITE_FLOAT && type == DatabaseImage::Integer)
+			type = DatabaseImage::Real;
+	}
+
+	vector<DatabaseImage::Cell> cells(rows.size());
+
+	for (size_t i = 0; i < rows.size(); ++i)
+		switch (types[i % columns])
+		{
+			case DatabaseImage::Integer:
+				cells[i].integer = rows[i].integer;
+				break;
+
+			case DatabaseImage::Real:
+				cells[i].real = rows[i].real;
+				break;
+
+			case DatabaseImage::Text:
+				cells[i].text = Intern(rows[i].text);
+				break;
+		}
+
+	table.name = Intern(name);
+	table.columns = columns;
+	table.rows = columns ? rows.size() / columns : 0;
+	table.reserved = 0;
+	table.types = Append(types.data(), types.size());
+	table.cells = Append(cells.data(), cells.size() * sizeof(DatabaseImage::Cell));
+
+	printf("%-16s %8u rows %3u columns\n", name.c_str(), table.rows, table.columns);
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: %s <database> [image]\n", argv[0]);
+		return 1;
+	}
+
+	string database = argv[1];
+	string output = argc > 2 ? argv[2] : database.substr(0, database.rfind('.')) + DatabaseImage::EXTENSION;
+
+	struct stat info;
+	sqlite3* db;
+
+	if (stat(database.c_str(), &info) != 0 || sqlite3_open_v2(database.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
+	{
+		fprintf(stderr, "Could not open SQLite3 database: %s\n", database.c_str());
+		return 1;
+	}
+
+	vector<string> names;
+	sqlite3_stmt* stmt;
+
+	if (sqlite3_prepare_v2(db, "SELECT name FROM sqlite_master WHERE type = 'table' ORDER BY name", -1, &stmt, nullptr) == SQLITE_OK)
+	{
+		while (sqlite3_step(stmt) == SQLITE_ROW)
+			names.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+
+		sqlite3_finalize(stmt);
+	}
+
+	DatabaseImage::Header header;
+	memset(&header, 0, sizeof(header));
+	header.magic = DatabaseImage::MAGIC;
+	header.version = DatabaseImage::VERSION;
+	header.tables = names.size();
+	header.source_size = info.st_size;
+	header.source_mtime = info.st_mtime;
+
+	vector<DatabaseImage::Table> tables(names.size());
+	image.resize(sizeof(header) + tables.size() * sizeof(DatabaseImage::Table));
+
+	for (size_t i = 0; i < names.size(); ++i)
+		if (!Compile(db, names[i], tables[i]))
+		{
+			sqlite3_close(db);
+			return 1;
+		}
+
+	sqlite3_close(db);
+
+	header.strings = Append(pool.data(), pool.size());
+	header.strings_size = pool.size();
+	memcpy(image.data(), &header, sizeof(header));
+	memcpy(image.data() + sizeof(header), tables.data(), tables.size() * sizeof(DatabaseImage::Table));
+
+	// written next to the target and renamed, a server starting meanwhile never maps a partial image
+	string temp = output + ".tmp";
+	FILE* file = fopen(temp.c_str(), "wb");
+
+	if (!file || fwrite(image.data(), 1, image.size(), file) != image.size() || fclose(file) != 0 || rename(temp.c_str(), output.c_str()) != 0)
+	{
+		fprintf(stderr, "Could not write database image: %s\n", output.c_str());
+		remove(temp.c_str());
+		return 1;
+	}
+
+	printf("Wrote %s: %u tables, %u bytes of strings, %u bytes\n", output.c_str(), header.tables, static_cast<unsigned int>(pool.size()), static_cast<unsigned int>(image.size()));
+	return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ * Models the delivery of batched callbacks to C++ scripts, one call per event against one OnEventBatch per tick.
+ *
+ * usage: eventbench <script.so> [events per tick] [ticks] [scripts]
+ *
+ * Script can't be linked on its own, it needs the game objects and through them the network packet sources. This
+ * repeats what Script::Call and Script::DispatchEvents do for a C++ script: the script is loaded with dlopen, the
+ * callback is looked up once and cached by its hash, and OnActorValueChange is raised for every event.
+ *
+ * single  calls the cached callback through a variadic function pointer for every event and script, as before
+ * batched appends a ScriptEvent per event and script and hands the events to OnEventBatch once per tick
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <chrono>
+#include <unordered_map>
+#include <dlfcn.h>
+
+#include "Utils.hpp"
+
+using namespace std;
+
+typedef unsigned long long NetworkID;
+typedef void(*FunctionEllipsis)(...);
+
+struct ScriptEvent
+{
+	unsigned int type;
+	NetworkID id;
+	NetworkID other;
+	unsigned int value;
+	double number;
+};
+
+static constexpr unsigned int ActorValueChange = 6;
+static constexpr unsigned int OnActorValueChange = Utils::hash("OnActorValueChange");
+
+struct Script
+{
+	void* lib;
+	unordered_map<unsigned int, FunctionEllipsis> callbacks_;
+	void(*batch_)(const ScriptEvent*, unsigned int);
+	vector<ScriptEvent> events_;
+
+	void Single(NetworkID id, unsigned char index, double value)
+	{
+		if (!callbacks_.count(OnActorValueChange))
+			callbacks_.emplace(OnActorValueChange, reinterpret_cast<FunctionEllipsis>(dlsym(lib, "OnActorValueChange")));
+
+		auto callback = callbacks_[OnActorValueChange];
+
+		if (callback)
+			callback(id, index, value);
+	}
+
+	void Batch(NetworkID id, unsigned char index, double value)
+	{
+		ScriptEvent event{ActorValueChange, id, 0, 0, 0.0};
+		event.value = index;
+		event.number = value;
+		events_.emplace_back(event);
+	}
+};
+
+static void Dispatch(vector<Script>& scripts)
+{
+	vector<ScriptEvent> events;
+
+	for (auto& script : scripts)
+	{
+		if (script.events_.empty())
+			continue;
+
+		events.swap(script.events_);
+		script.batch_(events.data(), events.size());
+		events.clear();
+
+		if (script.events_.empty())
+			events.swap(script.events_);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		printf("usage: %s <script.so> [events per tick] [ticks] [scripts]\n", argv[0]);
+		return 1;
+	}
+
+	unsigned int events = argc > 2 ? strtoul(argv[2], nullptr, 10) : 5000;
+	unsigned int ticks = argc > 3 ? strtoul(argv[3], nullptr, 10) : 200;
+	unsigned int count = argc > 4 ? strtoul(argv[4], nullptr, 10) : 1;
+
+	// every script is a copy of the same library, dlopen hands out the same handle
+	void* lib = dlopen(argv[1], RTLD_NOW | RTLD_LOCAL);
+
+	if (!lib)
+	{
+		printf("%s\n", dlerror());
+		return 1;
+	}
+
+	auto received = reinterpret_cast<double*>(dlsym(lib, "received"));
+	auto batch = reinterpret_cast<void(*)(const ScriptEvent*, unsigned int)>(dlsym(lib, "OnEventBatch"));
+
+	if (!received || !batch)
+	{
+		printf("%s doesn't export received and OnEventBatch\n", argv[1]);
+		return 1;
+	}
+
+	vector<Script> scripts(count);
+
+	for (auto& script : scripts)
+	{
+		script.lib = lib;
+		script.batch_ = batch;
+	}
+
+	printf("%u events per tick, %u ticks, %u scripts\n", events, ticks, count);
+	printf("%-10s %12s %14s %16s\n", "", "total ms", "ns per event", "received");
+
+	double single_ns = 0.0;
+
+	for (bool batched : {false, true})
+	{
+		*received = 0.0;
+		auto start = chrono::steady_clock::now();
+
+		for (unsigned int tick = 0; tick < ticks; ++tick)
+		{
+			for (unsigned int i = 0; i < events; ++i)
+				for (auto& script : scripts)
+					if (batched)
+						script.Batch(i + 1, i % 77, 100.0);
+					else
+						script.Single(i + 1, i % 77, 100.0);
+
+			if (batched)
+				Dispatch(scripts);
+		}
+
+		double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		double ns = ms * 1000000.0 / (static_cast<double>(events) * ticks * count);
+
+		if (!batched)
+			single_ns = ns;
+
+		printf("%-10s %12.3f %14.2f %16.0f", batched ? "batched" : "single", ms, ns, *received);
+
+		if (batched && ns > 0.0)
+			printf(" %8.1fx", single_ns / ns);
+
+		printf("\n");
+	}
+
+	dlclose(lib);
+	return 0;
+}
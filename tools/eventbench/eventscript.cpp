@@ -0,0 +1,24 @@
+/*
+ * The script eventbench loads, it receives OnActorValueChange either as its individual callback or through
+ * OnEventBatch and does the same work for both.
+ */
+
+#include "vaultscript.h"
+
+using namespace vaultmp;
+
+extern "C" {
+	VAULTVAR double received = 0.0;
+}
+
+Void VAULTSCRIPT OnActorValueChange(ID id, ActorValue index, Value value) noexcept
+{
+	received += static_cast<double>(id) + static_cast<double>(index) + value;
+}
+
+Void VAULTSCRIPT OnEventBatch(const Event* events, UCount count) noexcept
+{
+	for (const Event* event = events; event != events + count; ++event)
+		if (event->type == EventType::ActorValueChange)
+			received += static_cast<double>(event->id) + static_cast<double>(event->value) + event->number;
+}
@@ -0,0 +1,542 @@
+/*
+ * Models the script queries over the objects of GameFactory, as they were and as they are.
+ *
+ * usage: factorybench [actors] [others] [rounds] [scanned] [radius]
+ *
+ * GameFactory can't be linked on its own, it needs the game objects and through them the network packet sources. This
+ * keeps the instances as GameFactory does, in a map of shared pointers to their type guarded by the factory lock with
+ * an index by NetworkID, every object being a CriticalSection as Base is. There are as many actors as given, 10000 by
+ * default, among 40000 other objects.
+ *
+ * list  GetList(ID_ACTOR) as a C++ script sees it: before, GameFactory::GetByType built a vector, Script::GetList moved
+ *       it into a function-static vector and vaultscript.cpp copied that into the IDVector it returns. Now GetByType
+ *       fills the buffer of the script, either an IDVector the script keeps or a new one returned by value, which
+ *       is sized by GetCount first
+ * scan  a script reading position, cell and an actor value of every actor, 5000 by default: before, with GetPos,
+ *       GetCell and GetActorValue per actor, each looking the actor up under the factory lock and locking it. Now with
+ *       GetPosBatch, GetCellBatch and GetActorValueBatch, which look all actors up under one factory lock and lock
+ *       them in the order of their addresses, as GameFactory::Get does for a list of NetworkIDs. That order came
+ *       from a multimap before and comes from a sorted vector now, both are timed. What a call costs on the side of
+ *       the script, a PAWN native or a C++ call into vaultscript, is the same for both ways and not part of this
+ * grid  a script looking for the actors within a radius, 1024 by default, of a random point in a random cell, and for
+ *       the actors in a random cell: before, it walked GetList(ID_ACTOR) and asked GetCell and IsNearPoint of each.
+ *       Now GetObjectsInRadius and GetObjectsInCell ask the Grid, which is linked as the server builds it
+ *
+ * The objects are spread at random over 256 cells of 4096 units. No database is loaded, the Grid doesn't find the cells
+ * among the exteriors and gives each of them a space of its own as it does for interiors.
+ */
+
+#include "CriticalSection.hpp"
+#include "Guarded.hpp"
+#include "VaultVector.hpp"
+#include "vaultserver/Grid.hpp"
+#include "vaultserver/Exterior.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <tuple>
+#include <random>
+#include <memory>
+#include <chrono>
+#include <unordered_map>
+
+using namespace std;
+
+using RakNet::NetworkID;
+
+static constexpr unsigned int ID_REFERENCE = 0x00000001;
+static constexpr unsigned int ID_ACTOR = 0x00000010;
+static constexpr unsigned int CELLS = 256;
+
+struct Base : CriticalSection
+{
+	NetworkID id;
+	tuple<float, float, float> pos;
+	unsigned int cell;
+	double values[77];
+
+	Base(NetworkID id, unsigned int cell, const tuple<float, float, float>& pos) : id(id), pos(pos), cell(cell), values() { values[12] = id; }
+	NetworkID GetNetworkID() const { return id; }
+	bool IsNearPoint(float X, float Y, float Z, float R) const { return VaultVector(get<0>(pos), get<1>(pos), get<2>(pos)).IsNearPoint(VaultVector(X, Y, Z), R); }
+	const tuple<float, float, float>& GetNetworkPos() const { return pos; }
+	unsigned int GetNetworkCell() const { return cell; }
+	double GetActorValue(unsigned char index) const { return values[index]; }
+};
+
+typedef map<shared_ptr<Base>, unsigned int> BaseList;
+
+// Grid.cpp looks the cells up among the exteriors of the database, which isn't loaded here
+Expected<DB::Exterior*> DB::Exterior::Lookup(unsigned int baseID)
+{
+	return VaultException("No cell with baseID %08X found", baseID);
+}
+
+unsigned int DB::Exterior::GetWorld() const
+{
+	return world;
+}
+
+static Guarded<> cs;
+static BaseList instances;
+static unordered_map<NetworkID, BaseList::iterator> networkids;
+static unordered_map<unsigned int, unsigned int> typecount;
+
+namespace Before
+{
+	static vector<NetworkID> GetByType(unsigned int type)
+	{
+		return cs.Operate([type]() {
+			vector<NetworkID> result;
+			result.reserve(typecount[type]);
+
+			for (const auto& reference : instances)
+				if (reference.second & type)
+					result.emplace_back(reference.first->GetNetworkID());
+
+			return result;
+		});
+	}
+
+	static unsigned int GetList(unsigned int type, NetworkID** data)
+	{
+		static vector<NetworkID> _data;
+		_data = GetByType(type);
+		*data = &_data[0];
+		return _data.size();
+	}
+
+	static vector<NetworkID> ScriptGetList(unsigned int type)
+	{
+		NetworkID* data;
+		unsigned int size = GetList(type, &data);
+		return size ? vector<NetworkID>(data, data + size) : vector<NetworkID>();
+	}
+}
+
+namespace After
+{
+	static unsigned int GetCount(unsigned int type)
+	{
+		return cs.Operate([type]() {
+			unsigned int count = 0;
+
+			for (const auto& types : typecount)
+				if (types.first & type)
+					count += types.second;
+
+			return count;
+		});
+	}
+
+	static unsigned int GetByType(unsigned int type, NetworkID* data, unsigned int size)
+	{
+		return cs.Operate([type, data, size]() {
+			unsigned int count = 0;
+
+			for (const auto& reference : instances)
+				if (reference.second & type)
+				{
+					if (count < size)
+						data[count] = reference.first->GetNetworkID();
+
+					++count;
+				}
+
+			return count;
+		});
+	}
+
+	static unsigned int FillIDVector(unsigned int type, vector<NetworkID>& data)
+	{
+		unsigned int size;
+		data.resize(data.capacity());
+
+		while ((size = GetByType(type, data.data(), data.size())) > data.size())
+			data.resize(size);
+
+		data.resize(size);
+		return size;
+	}
+
+	static vector<NetworkID> ScriptGetList(unsigned int type)
+	{
+		vector<NetworkID> data;
+		data.reserve(GetCount(type));
+		FillIDVector(type, data);
+		return data;
+	}
+}
+
+// GameFactory::Operate for one NetworkID with RETURN_VALIDATED
+template<typename F>
+static auto Operate(NetworkID id, F function)
+{
+	pair<shared_ptr<Base>, unsigned int> base;
+
+	cs.Operate([id, &base]() {
+		auto it = networkids.find(id);
+
+		if (it != networkids.end())
+			base = *it->second;
+	});
+
+	if (!base.first || !base.first->StartSession())
+		return decltype(function(base.first.get()))();
+
+	auto result = function(base.first.get());
+	base.first->EndSession();
+	return result;
+}
+
+// GameFactory::Operate for a list of NetworkIDs with RETURN_EXPECTED, the missing ones are null. The objects are locked
+// in the order of their addresses, which a multimap of them gave before and a sorted vector of them gives now
+template<bool Multimap, typename F>
+static auto Operate(vector<NetworkID>&& ids, F function)
+{
+	vector<Base*> result(ids.size());
+	multimap<BaseList::value_type, unsigned int> tree;
+	vector<pair<pair<BaseList::key_type, BaseList::mapped_type>, unsigned int>> sort;
+
+	if (!Multimap)
+		sort.reserve(ids.size());
+
+	cs.Operate([&ids, &tree, &sort]() {
+		unsigned int i = 0;
+
+		for (auto id : ids)
+		{
+			auto it = networkids.find(id);
+
+			if (it != networkids.end())
+			{
+				if (Multimap)
+					tree.emplace(*it->second, i);
+				else
+					sort.emplace_back(*it->second, i);
+			}
+
+			++i;
+		}
+	});
+
+	if (Multimap)
+		for (const auto& base : tree)
+			result[base.second] = static_cast<Base*>(base.first.first->StartSession());
+	else
+	{
+		std::sort(sort.begin(), sort.end(), [](const auto& a, const auto& b) { return a.first.first < b.first.first; });
+
+		for (const auto& base : sort)
+			result[base.second] = static_cast<Base*>(base.first.first->StartSession());
+	}
+
+	auto value = function(result);
+
+	for (Base* base : result)
+		if (base)
+			base->EndSession();
+
+	return value;
+}
+
+namespace Before
+{
+	static void GetPos(NetworkID id, double* X, double* Y, double* Z)
+	{
+		*X = *Y = *Z = 0.00;
+
+		Operate(id, [X, Y, Z](Base* object) {
+			const auto& pos = object->GetNetworkPos();
+			*X = get<0>(pos);
+			*Y = get<1>(pos);
+			*Z = get<2>(pos);
+			return true;
+		});
+	}
+
+	static unsigned int GetCell(NetworkID id)
+	{
+		return Operate(id, [](Base* object) { return object->GetNetworkCell(); });
+	}
+
+	static double GetActorValue(NetworkID id, unsigned char index)
+	{
+		return Operate(id, [index](Base* actor) { return actor->GetActorValue(index); });
+	}
+
+	static bool IsNearPoint(NetworkID id, double X, double Y, double Z, double R)
+	{
+		return Operate(id, [X, Y, Z, R](Base* object) { return object->IsNearPoint(X, Y, Z, R); });
+	}
+
+	// what a script did without GetObjectsInRadius and GetObjectsInCell, R below zero asks for the whole cell
+	static unsigned int GetInRadius(unsigned int cell, double X, double Y, double Z, double R, vector<NetworkID>& data)
+	{
+		data.clear();
+
+		for (NetworkID id : After::ScriptGetList(ID_ACTOR))
+			if (GetCell(id) == cell && (R < 0.0 || IsNearPoint(id, X, Y, Z, R)))
+				data.emplace_back(id);
+
+		return data.size();
+	}
+}
+
+namespace After
+{
+	template<bool Multimap>
+	static unsigned int GetPosBatch(const NetworkID* ids, unsigned int count, double* X, double* Y, double* Z)
+	{
+		return Operate<Multimap>(vector<NetworkID>(ids, ids + count), [count, X, Y, Z](vector<Base*>& objects) {
+			unsigned int found = 0;
+
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				if (!objects[i])
+				{
+					X[i] = Y[i] = Z[i] = 0.00;
+					continue;
+				}
+
+				const auto& pos = objects[i]->GetNetworkPos();
+				X[i] = get<0>(pos);
+				Y[i] = get<1>(pos);
+				Z[i] = get<2>(pos);
+				++found;
+			}
+
+			return found;
+		});
+	}
+
+	template<bool Multimap>
+	static unsigned int GetCellBatch(const NetworkID* ids, unsigned int count, unsigned int* cells)
+	{
+		return Operate<Multimap>(vector<NetworkID>(ids, ids + count), [count, cells](vector<Base*>& objects) {
+			unsigned int found = 0;
+
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				cells[i] = objects[i] ? objects[i]->GetNetworkCell() : 0u;
+				found += objects[i] != nullptr;
+			}
+
+			return found;
+		});
+	}
+
+	template<bool Multimap>
+	static unsigned int GetActorValueBatch(const NetworkID* ids, unsigned int count, unsigned char index, double* values)
+	{
+		return Operate<Multimap>(vector<NetworkID>(ids, ids + count), [count, index, values](vector<Base*>& actors) {
+			unsigned int found = 0;
+
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				values[i] = actors[i] ? actors[i]->GetActorValue(index) : 0.00;
+				found += actors[i] != nullptr;
+			}
+
+			return found;
+		});
+	}
+}
+
+namespace After
+{
+	static unsigned int GetType(NetworkID id)
+	{
+		return cs.Operate([id]() {
+			auto it = networkids.find(id);
+			return it != networkids.end() ? it->second->second : 0x00000000;
+		});
+	}
+
+	static unsigned int FillList(const vector<NetworkID>& source, NetworkID* data, unsigned int size)
+	{
+		copy_n(source.begin(), min(size, static_cast<unsigned int>(source.size())), data);
+		return source.size();
+	}
+
+	static unsigned int GetObjectsInRadius(unsigned int cell, double X, double Y, double Z, double R, unsigned int type, NetworkID* data, unsigned int size)
+	{
+		auto ids = Grid::GetInRadius(cell, X, Y, Z, R);
+		ids.erase(remove_if(ids.begin(), ids.end(), [type](NetworkID id) { return !(GetType(id) & type); }), ids.end());
+		return FillList(ids, data, size);
+	}
+
+	static unsigned int GetObjectsInCell(unsigned int cell, unsigned int type, NetworkID* data, unsigned int size)
+	{
+		auto ids = Grid::GetInCell(cell);
+		ids.erase(remove_if(ids.begin(), ids.end(), [type](NetworkID id) { return !(GetType(id) & type); }), ids.end());
+		return FillList(ids, data, size);
+	}
+}
+
+// sums what the script read, so that both ways can be compared
+static unsigned long long Sum(unsigned int count, const double* X, const double* Y, const double* Z, const unsigned int* cells, const double* values)
+{
+	double sum = 0.0;
+
+	for (unsigned int i = 0; i < count; ++i)
+		sum += X[i] + Y[i] + Z[i] + cells[i] + values[i];
+
+	return static_cast<unsigned long long>(sum);
+}
+
+template<typename F>
+static double Time(unsigned int rounds, F function, unsigned long long& result)
+{
+	result = 0;
+	auto start = chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < rounds; ++i)
+		result += function();
+
+	return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / rounds;
+}
+
+static void Print(const char* name, double us, double base, bool same)
+{
+	printf("%-40s %10.1f us %8.2fx %s\n", name, us, us > 0.0 ? base / us : 0.0, same ? "" : "RESULTS DIFFER");
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int actors = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000;
+	unsigned int others = argc > 2 ? strtoul(argv[2], nullptr, 10) : 40000;
+	unsigned int rounds = argc > 3 ? strtoul(argv[3], nullptr, 10) : 1000;
+	unsigned int scanned = argc > 4 ? strtoul(argv[4], nullptr, 10) : 5000;
+	float radius = argc > 5 ? strtof(argv[5], nullptr) : 1024.0f;
+
+	unsigned long long total = actors + others;
+
+	// the same seed every run, the cells get IDs of their own above the ones of the game
+	mt19937 random(0);
+	uniform_int_distribution<unsigned int> cell(0x01000000, 0x01000000 + CELLS - 1);
+	uniform_real_distribution<float> coord(0.0f, DB::Exterior::SIZE);
+	uniform_real_distribution<float> height(0.0f, 512.0f);
+
+	// the actors are spread evenly over the objects
+	for (unsigned int i = 0; i < total; ++i)
+	{
+		unsigned int type = i * actors / total != (i + 1) * actors / total ? ID_ACTOR : ID_REFERENCE;
+		auto pos = make_tuple(coord(random), coord(random), height(random));
+		auto it = instances.emplace(make_shared<Base>(i + 1, cell(random), pos), type).first;
+		networkids.emplace(i + 1, it);
+		++typecount[type];
+	}
+
+	for (const auto& reference : instances)
+		Grid::Update(reference.first->GetNetworkID(), reference.first->GetNetworkCell(), reference.first->GetNetworkPos());
+
+	printf("%u actors among %llu objects, %u rounds, us per call\n", typecount[ID_ACTOR], total, rounds);
+
+	unsigned long long a, b, c;
+	vector<NetworkID> kept;
+
+	double before = Time(rounds, []() { return Before::ScriptGetList(ID_ACTOR).size(); }, a);
+	double returned = Time(rounds, []() { return After::ScriptGetList(ID_ACTOR).size(); }, b);
+	double reused = Time(rounds, [&kept]() { return After::FillIDVector(ID_ACTOR, kept); }, c);
+
+	Print("GetList before", before, before, true);
+	Print("GetList returning an IDVector", returned, before, a == b);
+	Print("GetList into a kept IDVector", reused, before, a == c);
+
+	vector<NetworkID> ids = After::ScriptGetList(ID_ACTOR);
+
+	if (ids.size() > scanned)
+		ids.resize(scanned);
+
+	unsigned int count = ids.size();
+	vector<double> X(count), Y(count), Z(count), values(count);
+	vector<unsigned int> cells(count);
+
+	printf("\nscan of %u actors, %u rounds, us per scan\n", count, rounds);
+
+	before = Time(rounds, [&]() {
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			Before::GetPos(ids[i], &X[i], &Y[i], &Z[i]);
+			cells[i] = Before::GetCell(ids[i]);
+			values[i] = Before::GetActorValue(ids[i], 12);
+		}
+
+		return Sum(count, X.data(), Y.data(), Z.data(), cells.data(), values.data());
+	}, a);
+
+	double tree = Time(rounds, [&]() {
+		After::GetPosBatch<true>(ids.data(), count, X.data(), Y.data(), Z.data());
+		After::GetCellBatch<true>(ids.data(), count, cells.data());
+		After::GetActorValueBatch<true>(ids.data(), count, 12, values.data());
+		return Sum(count, X.data(), Y.data(), Z.data(), cells.data(), values.data());
+	}, b);
+
+	double batched = Time(rounds, [&]() {
+		After::GetPosBatch<false>(ids.data(), count, X.data(), Y.data(), Z.data());
+		After::GetCellBatch<false>(ids.data(), count, cells.data());
+		After::GetActorValueBatch<false>(ids.data(), count, 12, values.data());
+		return Sum(count, X.data(), Y.data(), Z.data(), cells.data(), values.data());
+	}, c);
+
+	Print("GetPos, GetCell, GetActorValue", before, before, true);
+	Print("...Batch, locked through a multimap", tree, before, a == b);
+	Print("...Batch, locked through a sorted vector", batched, before, a == c);
+
+	struct Query { unsigned int cell; float X, Y, Z; };
+	vector<Query> queries(rounds);
+
+	for (auto& query : queries)
+		query = {cell(random), coord(random), coord(random), height(random)};
+
+	// the order of the results differs, their sum doesn't
+	auto sum = [](const NetworkID* data, unsigned int size) {
+		unsigned long long result = 0;
+
+		for (unsigned int i = 0; i < size; ++i)
+			result += data[i];
+
+		return result;
+	};
+
+	vector<NetworkID> found;
+	NetworkID buffer[4096];
+	unsigned int query;
+
+	printf("\ngrid with %u objects in %u cells, %u queries, us per query\n", static_cast<unsigned int>(total), CELLS, rounds);
+
+	query = 0;
+	before = Time(rounds, [&]() {
+		const Query& q = queries[query++ % rounds];
+		return sum(found.data(), Before::GetInRadius(q.cell, q.X, q.Y, q.Z, radius, found));
+	}, a);
+
+	query = 0;
+	double grid = Time(rounds, [&]() {
+		const Query& q = queries[query++ % rounds];
+		return sum(buffer, After::GetObjectsInRadius(q.cell, q.X, q.Y, q.Z, radius, ID_ACTOR, buffer, 4096));
+	}, b);
+
+	Print("GetList, GetCell and IsNearPoint", before, before, true);
+	Print("GetObjectsInRadius", grid, before, a == b);
+
+	query = 0;
+	before = Time(rounds, [&]() {
+		const Query& q = queries[query++ % rounds];
+		return sum(found.data(), Before::GetInRadius(q.cell, 0.0, 0.0, 0.0, -1.0, found));
+	}, a);
+
+	query = 0;
+	grid = Time(rounds, [&]() {
+		const Query& q = queries[query++ % rounds];
+		return sum(buffer, After::GetObjectsInCell(q.cell, ID_ACTOR, buffer, 4096));
+	}, b);
+
+	Print("GetList and GetCell", before, before, true);
+	Print("GetObjectsInCell", grid, before, a == b);
+
+	return 0;
+}
@@ -0,0 +1,220 @@
+/*
+ * Models the item lookups of ItemList with and without its index by baseID.
+ *
+ * usage: itembench [items...]
+ *
+ * ItemList can't be linked on its own, it needs GameFactory and through it the network packet sources. This models
+ * what its lookups cost: every access to an item goes through GameFactory::Operate, which takes the factory lock,
+ * finds the item in the factory index, copies its shared pointer and locks the item. An inventory holds items of as
+ * many distinct bases as given, 1000 and 4000 by default.
+ *
+ * scan     looks at every item of the list, as ItemList did before
+ * indexed  looks at the items of the requested base only, through the index by baseID
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+
+using namespace std;
+
+typedef unsigned long long NetworkID;
+
+struct Item
+{
+	unsigned int base;
+	float condition;
+	unsigned int count;
+	mutex lock;
+};
+
+static mutex cs;
+static unordered_map<NetworkID, shared_ptr<Item>> factory;
+
+template<typename F>
+static auto Operate(NetworkID id, F function)
+{
+	shared_ptr<Item> item;
+
+	{
+		lock_guard<mutex> guard(cs);
+		auto it = factory.find(id);
+
+		if (it != factory.end())
+			item = it->second;
+	}
+
+	lock_guard<mutex> guard(item->lock);
+	return function(item.get());
+}
+
+struct ItemList
+{
+	vector<NetworkID> container;
+	unordered_map<unsigned int, vector<NetworkID>> bases;
+
+	NetworkID FindScan(unsigned int base, float condition) const
+	{
+		for (NetworkID id : container)
+			if (Operate(id, [base, condition](Item* item) { return item->base == base && item->condition == condition; }))
+				return id;
+
+		return 0;
+	}
+
+	NetworkID FindIndexed(unsigned int base, float condition) const
+	{
+		auto it = bases.find(base);
+
+		if (it == bases.end())
+			return 0;
+
+		for (NetworkID id : it->second)
+			if (Operate(id, [condition](Item* item) { return item->condition == condition; }))
+				return id;
+
+		return 0;
+	}
+
+	unsigned int CountScan(unsigned int base) const
+	{
+		unsigned int count = 0;
+
+		for (NetworkID id : container)
+			count += Operate(id, [base](Item* item) { return item->base == base ? item->count : 0; });
+
+		return count;
+	}
+
+	unsigned int CountIndexed(unsigned int base) const
+	{
+		auto it = bases.find(base);
+		unsigned int count = 0;
+
+		if (it != bases.end())
+			for (NetworkID id : it->second)
+				count += Operate(id, [](Item* item) { return item->count; });
+
+		return count;
+	}
+
+	// AddItem: stacks onto an item of the same base and condition, else inserts the new item
+	void Add(NetworkID id, bool indexed)
+	{
+		auto data = Operate(id, [](Item* item) { return make_pair(item->base, item->condition); });
+		NetworkID stackable = indexed ? FindIndexed(data.first, data.second) : FindScan(data.first, data.second);
+
+		if (stackable)
+			Operate(stackable, [](Item* item) { ++item->count; });
+		else
+		{
+			container.emplace_back(id);
+			bases[data.first].emplace_back(id);
+		}
+	}
+};
+
+static double Time(function<unsigned long long()> run, unsigned long long& result)
+{
+	auto start = chrono::steady_clock::now();
+	result = run();
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static void Compare(const char* name, function<unsigned long long()> scan, function<unsigned long long()> indexed)
+{
+	unsigned long long a, b;
+	double ta = Time(scan, a);
+	double tb = Time(indexed, b);
+
+	printf("%-34s %10.3f ms %10.3f ms %8.1fx %s\n", name, ta, tb, tb > 0.0 ? ta / tb : 0.0, a == b ? "" : "RESULTS DIFFER");
+}
+
+static void Run(unsigned int count)
+{
+	factory.clear();
+
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		auto item = make_shared<Item>();
+		item->base = 0x00010000 + i;
+		item->condition = 100.0f;
+		item->count = 1;
+		factory.emplace(i + 1, item);
+	}
+
+	// the inventory is populated by both ways from the same items, stacking nothing as every base is distinct
+	ItemList scan, indexed;
+	char name[64];
+
+	printf("\n%u items of %u bases\n", count, count);
+	printf("%-34s %13s %13s\n", "", "scan", "indexed");
+
+	snprintf(name, sizeof(name), "populate with %u AddItem", count);
+	Compare(name, [&scan, count]() {
+		for (unsigned int i = 0; i < count; ++i)
+			scan.Add(i + 1, false);
+
+		return scan.container.size();
+	}, [&indexed, count]() {
+		for (unsigned int i = 0; i < count; ++i)
+			indexed.Add(i + 1, true);
+
+		return indexed.container.size();
+	});
+
+	snprintf(name, sizeof(name), "%u FindStackableItem", count);
+	Compare(name, [&scan, count]() {
+		unsigned long long sum = 0;
+
+		for (unsigned int i = 0; i < count; ++i)
+			sum += scan.FindScan(0x00010000 + i, 100.0f);
+
+		return sum;
+	}, [&indexed, count]() {
+		unsigned long long sum = 0;
+
+		for (unsigned int i = 0; i < count; ++i)
+			sum += indexed.FindIndexed(0x00010000 + i, 100.0f);
+
+		return sum;
+	});
+
+	snprintf(name, sizeof(name), "%u GetItemCount(baseID)", count);
+	Compare(name, [&scan, count]() {
+		unsigned long long sum = 0;
+
+		for (unsigned int i = 0; i < count; ++i)
+			sum += scan.CountScan(0x00010000 + i);
+
+		return sum;
+	}, [&indexed, count]() {
+		unsigned long long sum = 0;
+
+		for (unsigned int i = 0; i < count; ++i)
+			sum += indexed.CountIndexed(0x00010000 + i);
+
+		return sum;
+	});
+}
+
+int main(int argc, char* argv[])
+{
+	vector<unsigned int> counts;
+
+	for (int i = 1; i < argc; ++i)
+		counts.emplace_back(strtoul(argv[i], nullptr, 10));
+
+	if (counts.empty())
+		counts = {1000, 4000};
+
+	for (unsigned int count : counts)
+		Run(count);
+
+	return 0;
+}
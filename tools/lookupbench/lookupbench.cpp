@@ -0,0 +1,823 @@
+/*
+ * Measures the dedicated server's database lookups on the Fallout 3 data in other/data3.
+ *
+ * usage: lookupbench [data directory] [rounds] [containers]
+ *
+ * The dumps are imported into data/lookupbench.sqlite3 below the working directory like the scripts in other/ import
+ * them, then loaded through Database<T> the way GameFactory::Initialize loads the game database. Each lookup is
+ * timed against the way it was done before it was indexed, both over the same loaded records, and the results of
+ * both are compared. Times are the best of all rounds.
+ *
+ * Before that the whole load is timed in child processes, once one database after another as GameFactory::Initialize
+ * did before and once concurrently as it does with more than one hardware thread, so that every load starts from empty
+ * indexes. The best of up to five loads each is printed, with the number of hardware threads the loads could spread
+ * over.
+ *
+ * The persistent references the server instantiates as objects are counted the way Script::Initialize created them
+ * all at startup before, and the way Script::LoadCells creates them per cell now, for the default spawn cell and its
+ * adjacent cells and for every cell.
+ *
+ * The shipped data has few base containers. With a count of containers, as many base containers holding 12 items
+ * each are added to contitems and populated instead of the containers of the CONT references.
+ */
+
+#include "Database.hpp"
+#include "Record.hpp"
+#include "Race.hpp"
+#include "NPC.hpp"
+#include "BaseContainer.hpp"
+#include "Exterior.hpp"
+#include "Reference.hpp"
+#include "Item.hpp"
+
+#include "sqlite/sqlite3.h"
+
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+static const char* DATABASE = "lookupbench.sqlite3";
+static const vector<string> REFERENCES = {"refs_CONT", "refs_DOOR", "refs_TERM", "refs_STAT"};
+static const vector<string> RECORDS = {"CONT", "NPC_", "CREA", "LVLI", "ALCH", "AMMO", "ARMA", "ARMO", "BOOK", "ENCH", "KEYM", "MISC", "NOTE", "WEAP", "CELL", "IDLE", "WTHR", "STAT", "MSTT", "RACE", "LIGH", "DOOR", "TERM", "EXPL", "PROJ", "STAT", "SOUN"};
+
+static sqlite3* db;
+static string directory = "../../other/data3";
+static unsigned int rounds = 20;
+static unsigned int synthetic = 0;
+
+/**
+ * Imports one dump, every line is split at '|' and passed to row, which names the table and fills the values.
+ * Values starting with 0x are bound as integers, others as text which SQLite converts by column affinity,
+ * the same as the PHP scripts do.
+ */
+static unsigned int Import(const string& file, const char* schema, function<bool(vector<string>&, string&)> row)
+{
+	ifstream dump(directory + "/" + file);
+	string line, table;
+	vector<string> fields;
+	vector<string> created;
+	unsigned int count = 0;
+
+	if (!dump)
+	{
+		fprintf(stderr, "Could not open %s/%s\n", directory.c_str(), file.c_str());
+		exit(1);
+	}
+
+	while (getline(dump, line))
+	{
+		line.erase(remove(line.begin(), line.end(), '\r'), line.end());
+
+		if (line.empty())
+			continue;
+
+		fields.clear();
+
+		for (size_t pos = 0, end; ; pos = end + 1)
+		{
+			end = line.find('|', pos);
+			fields.emplace_back(line.substr(pos, end - pos));
+
+			if (end == string::npos)
+				break;
+		}
+
+		if (!row(fields, table))
+			continue;
+
+		if (find(created.begin(), created.end(), table) == created.end())
+		{
+			string create = "CREATE TABLE IF NOT EXISTS \"" + table + "\" " + schema;
+			sqlite3_exec(db, create.c_str(), nullptr, nullptr, nullptr);
+			created.emplace_back(table);
+		}
+
+		string insert = "INSERT INTO \"" + table + "\" VALUES (?";
+
+		for (size_t i = 1; i < fields.size(); ++i)
+			insert += ", ?";
+
+		insert += ")";
+
+		sqlite3_stmt* stmt;
+
+		if (sqlite3_prepare_v2(db, insert.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+		{
+			fprintf(stderr, "Could not prepare query: %s\n", sqlite3_errmsg(db));
+			exit(1);
+		}
+
+		for (size_t i = 0; i < fields.size(); ++i)
+			if (!fields[i].compare(0, 2, "0x"))
+				sqlite3_bind_int64(stmt, i + 1, strtoul(fields[i].c_str(), nullptr, 16));
+			else
+				sqlite3_bind_text(stmt, i + 1, fields[i].c_str(), -1, SQLITE_TRANSIENT);
+
+		sqlite3_step(stmt);
+		sqlite3_finalize(stmt);
+		++count;
+	}
+
+	return count;
+}
+
+static void Import()
+{
+	mkdir(DATA_PATH, 0755);
+	string file = string(DATA_PATH) + "/" + DATABASE;
+	remove(file.c_str());
+
+	if (sqlite3_open(file.c_str(), &db) != SQLITE_OK)
+	{
+		fprintf(stderr, "Could not create %s\n", file.c_str());
+		exit(1);
+	}
+
+	sqlite3_exec(db, "PRAGMA synchronous = OFF; BEGIN", nullptr, nullptr, nullptr);
+
+	// DLC indexes as assigned by the import scripts
+	static const char* records[] = {"base.TXT", "pitt.TXT", "anchor.TXT", "bs.TXT", "pl.TXT", "ze.TXT"};
+	static const char* dlcs[] = {"main", "tp", "oa", "bsn", "pl", "mz"};
+	static const char* cells[] = {"base", "tp", "oa", "bs", "pl"};
+	unsigned int count = 0;
+
+	for (unsigned int dlc = 0; dlc < 6; ++dlc)
+	{
+		string prefix = string("f3_") + dlcs[dlc] + "_";
+		string index = "0x" + to_string(dlc);
+
+		// f3.php, only the tables GameFactory reads
+		count += Import(records[dlc], "(baseID integer, name varchar(128), description varchar(128), dlc integer)", [&index](vector<string>& f, string& table) {
+			if (f.size() < 4 || find(RECORDS.begin(), RECORDS.end(), f[0]) == RECORDS.end())
+				return false;
+
+			table = f[0];
+			f = {f[1], f[2], f[3], index};
+			return true;
+		});
+
+		count += Import(prefix + "races.txt", "(baseID integer, child integer, younger integer, older integer, dlc integer)", [&index](vector<string>& f, string& table) {
+			table = "races";
+			f = {f[0], f[2], f[3], f[4], index};
+			return strtoul(f[0].c_str(), nullptr, 16) != 0;
+		});
+
+		count += Import(prefix + "npc.txt", "(baseID integer, essential integer, female integer, race integer, template integer, flags integer, deathitem integer, dlc integer)", [&index](vector<string>& f, string& table) {
+			table = "npcs";
+			f = {f[0], f[3], f[1], f[2], f[5], f[6], f[4], index};
+			return strtoul(f[0].c_str(), nullptr, 16) != 0;
+		});
+
+		count += Import(prefix + "npc_items.txt", "(baseID integer, item integer, count integer, condition float, dlc integer)", [&index](vector<string>& f, string& table) {
+			table = "npcitems";
+			f = {f[0], f[1], f[2], f[3], index};
+			return strtoul(f[0].c_str(), nullptr, 16) != 0;
+		});
+
+		count += Import(prefix + "containerobjects.txt", "(baseID integer, item integer, count integer, condition float, dlc integer)", [&index](vector<string>& f, string& table) {
+			table = "contitems";
+			f = {f[0], f[1], f[2], f[4], index};
+			return strtoul(f[0].c_str(), nullptr, 16) != 0;
+		});
+
+		// f3_extcells.php imports no cells of Mothership Zeta
+		if (dlc < 5)
+			count += Import(string(cells[dlc]) + "_cells_list.txt", "(baseID integer, x integer, y integer, wrld integer, dlc integer)", [&index](vector<string>& f, string& table) {
+				table = "exteriors";
+				f = {f[1], f[2], f[3], f[4], index};
+				return strtoul(f[0].c_str(), nullptr, 16) != 0;
+			});
+
+		// there are no dumps of the references of the main file and of Point Lookout
+		if (dlc && dlc != 4)
+			count += Import(prefix + "refr.txt", "(editor varchar(128), refID integer, baseID integer, count integer, health float, cell integer, x float, y float, z float, ax float, ay float, az float, flags integer, lock integer, key integer, link integer, dlc integer)", [&index](vector<string>& f, string& table) {
+				table = "refs_" + f[0];
+
+				if (find(REFERENCES.begin(), REFERENCES.end(), table) == REFERENCES.end())
+					return false;
+
+				f.erase(f.begin());
+				f.emplace_back(index);
+				return strtoul(f[1].c_str(), nullptr, 16) != 0;
+			});
+	}
+
+	// there is no dump of the items table, every item record gets a row
+	sqlite3_exec(db, "CREATE TABLE items (baseID integer, value integer, health integer, weight float, slot integer, dlc integer)", nullptr, nullptr, nullptr);
+
+	for (const char* type : {"ALCH", "AMMO", "ARMO", "BOOK", "KEYM", "MISC", "NOTE", "WEAP"})
+	{
+		string insert = string("INSERT INTO items SELECT baseID, length(name) * 5, 100, 1.0, 0, dlc FROM ") + type;
+		sqlite3_exec(db, insert.c_str(), nullptr, nullptr, nullptr);
+		count += sqlite3_changes(db);
+	}
+
+	if (synthetic)
+	{
+		vector<unsigned int> items;
+		sqlite3_stmt* stmt;
+		sqlite3_prepare_v2(db, "SELECT baseID FROM items WHERE dlc = 0", -1, &stmt, nullptr);
+
+		while (sqlite3_step(stmt) == SQLITE_ROW)
+			items.emplace_back(sqlite3_column_int(stmt, 0));
+
+		sqlite3_finalize(stmt);
+		sqlite3_prepare_v2(db, "INSERT INTO contitems VALUES (?, ?, ?, 1.0, 0)", -1, &stmt, nullptr);
+
+		for (unsigned int i = 0; i < synthetic && !items.empty(); ++i)
+			for (unsigned int j = 0; j < 12; ++j)
+			{
+				sqlite3_bind_int(stmt, 1, 0x00F00000 + i);
+				sqlite3_bind_int(stmt, 2, items[(i * 7 + j * 13) % items.size()]);
+				sqlite3_bind_int(stmt, 3, j + 1);
+				sqlite3_step(stmt);
+				sqlite3_reset(stmt);
+				++count;
+			}
+
+		sqlite3_finalize(stmt);
+	}
+
+	sqlite3_exec(db, "COMMIT", nullptr, nullptr, nullptr);
+	sqlite3_close(db);
+	printf("Imported %u rows from %s into %s\n", count, directory.c_str(), file.c_str());
+}
+
+static double Measure(function<unsigned long long()> run, unsigned long long& result)
+{
+	double best = 0.0;
+
+	for (unsigned int i = 0; i < rounds; ++i)
+	{
+		auto start = chrono::steady_clock::now();
+		result = run();
+		double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+		if (!i || ms < best)
+			best = ms;
+	}
+
+	return best;
+}
+
+static void Compare(const char* name, function<unsigned long long()> indexed, function<unsigned long long()> baseline)
+{
+	unsigned long long a, b;
+	double ta = Measure(indexed, a);
+	double tb = Measure(baseline, b);
+
+	printf("%-28s %10.3f ms %10.3f ms %6.1fx %s\n", name, ta, tb, ta > 0.0 ? tb / ta : 0.0, a == b ? "" : "RESULTS DIFFER");
+}
+
+// has access to Database<T> like the server's GameFactory
+class GameFactory
+{
+	private:
+		static Database<DB::Record> dbRecords;
+		static Database<DB::Race> dbRaces;
+		static Database<DB::NPC> dbNpcs;
+		static Database<DB::BaseContainer> dbContainers;
+		static Database<DB::Exterior> dbExteriors;
+		static Database<DB::Reference> dbReferences;
+		static Database<DB::Item> dbItems;
+
+		static void Time(const char* name, function<void()> load)
+		{
+			auto start = chrono::steady_clock::now();
+			load();
+			printf("%-28s %10.3f ms\n", name, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+		}
+
+	public:
+		static void Load()
+		{
+			Time("load records", []() { dbRecords.initialize(DATABASE, RECORDS); });
+			Time("load races", []() { dbRaces.initialize(DATABASE, {"races"}); });
+			Time("load npcs", []() { dbNpcs.initialize(DATABASE, {"npcs"}); });
+			Time("NPC::ResolveTemplates", []() { DB::NPC::ResolveTemplates(); });
+			Time("load containers", []() { dbContainers.initialize(DATABASE, {"npcitems", "contitems"}); });
+			Time("BaseContainer::Index", []() { DB::BaseContainer::Index(); });
+			Time("load exteriors", []() { dbExteriors.initialize(DATABASE, {"exteriors"}); });
+			Time("load references", []() { dbReferences.initialize(DATABASE, REFERENCES); });
+			Time("Reference::Index", []() { DB::Reference::Index(); });
+			Time("load items", []() { dbItems.initialize(DATABASE, {"items"}); });
+		}
+
+		// the same databases as Load, with the tasks and dependencies of GameFactory::Initialize, always launched on threads
+		static void LoadConcurrently()
+		{
+			shared_future<void> records = async(launch::async, []() { dbRecords.initialize(DATABASE, RECORDS); }).share();
+			shared_future<void> exteriors = async(launch::async, []() { dbExteriors.initialize(DATABASE, {"exteriors"}); }).share();
+
+			future<void> loads[] = {
+				async(launch::async, []() { dbRaces.initialize(DATABASE, {"races"}); }),
+				async(launch::async, []() { dbNpcs.initialize(DATABASE, {"npcs"}); DB::NPC::ResolveTemplates(); }),
+				async(launch::async, [records]() { records.get(); dbContainers.initialize(DATABASE, {"npcitems", "contitems"}); DB::BaseContainer::Index(); }),
+				async(launch::async, []() { dbItems.initialize(DATABASE, {"items"}); }),
+				async(launch::async, [exteriors]() { exteriors.get(); dbReferences.initialize(DATABASE, REFERENCES); DB::Reference::Index(); }),
+			};
+
+			records.get();
+			exteriors.get();
+
+			for (auto& load : loads)
+				load.get();
+		}
+
+		static const vector<DB::NPC>& GetNPCs() { return dbNpcs.data; }
+		static const vector<DB::BaseContainer>& GetContainers() { return dbContainers.data; }
+		static const vector<DB::Item>& GetItems() { return dbItems.data; }
+};
+
+Database<DB::Record> GameFactory::dbRecords;
+Database<DB::Race> GameFactory::dbRaces;
+Database<DB::NPC> GameFactory::dbNpcs;
+Database<DB::BaseContainer> GameFactory::dbContainers;
+Database<DB::Exterior> GameFactory::dbExteriors;
+Database<DB::Reference> GameFactory::dbReferences;
+Database<DB::Item> GameFactory::dbItems;
+
+// loads all databases in a child process and returns the wall clock time it took, below zero if the load failed
+static double Startup(bool concurrent)
+{
+	int fds[2];
+
+	if (pipe(fds))
+		return -1.0;
+
+	fflush(stdout);
+	pid_t pid = fork();
+
+	if (!pid)
+	{
+		close(fds[0]);
+
+		// every database prints a line when it has been read
+		if (!freopen("/dev/null", "w", stdout))
+			_exit(1);
+
+		auto start = chrono::steady_clock::now();
+
+		try
+		{
+			if (concurrent)
+				GameFactory::LoadConcurrently();
+			else
+				GameFactory::Load();
+		}
+		catch (exception&)
+		{
+			_exit(1);
+		}
+
+		double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		_exit(write(fds[1], &ms, sizeof(ms)) == sizeof(ms) ? 0 : 1);
+	}
+
+	close(fds[1]);
+	double ms = -1.0;
+
+	if (pid < 0 || read(fds[0], &ms, sizeof(ms)) != sizeof(ms))
+		ms = -1.0;
+
+	close(fds[0]);
+
+	if (pid > 0)
+		waitpid(pid, nullptr, 0);
+
+	return ms;
+}
+
+static void Startup()
+{
+	unsigned int loads = min(rounds, 5u);
+	double sequential = 0.0, concurrent = 0.0;
+
+	for (unsigned int i = 0; i < loads; ++i)
+	{
+		double a = Startup(false);
+		double b = Startup(true);
+
+		if (a < 0.0 || b < 0.0)
+		{
+			fprintf(stderr, "Could not load the database in a child process\n");
+			return;
+		}
+
+		if (!i || a < sequential)
+			sequential = a;
+
+		if (!i || b < concurrent)
+			concurrent = b;
+	}
+
+	printf("\nstartup, best of %u loads on %u hardware threads\n", loads, thread::hardware_concurrency());
+	printf("%-28s %13s %13s\n", "", "concurrent", "sequential");
+	printf("%-28s %10.3f ms %10.3f ms %6.1fx\n\n", "load all databases", concurrent, sequential, concurrent > 0.0 ? sequential / concurrent : 0.0);
+}
+
+// template flags as in NPC.hpp
+static const unsigned short Traits = 0x0001, Base = 0x0080, Inventory = 0x0100;
+
+// follows the template chain on every call, like the accessors did before the chains were resolved at load
+static const DB::NPC* Walk(const DB::NPC* npc, unsigned short flag)
+{
+	while (npc->GetTemplate() && (npc->GetFlags() & flag))
+	{
+		auto next = DB::NPC::Lookup(npc->GetTemplate());
+
+		if (!next)
+			break;
+
+		npc = *next;
+	}
+
+	return npc;
+}
+
+static void Templates()
+{
+	const auto& npcs = GameFactory::GetNPCs();
+	unsigned int templated = count_if(npcs.begin(), npcs.end(), [](const DB::NPC& npc) { return npc.GetTemplate() != 0; });
+
+	printf("\n%u NPCs, %u with a template\n", static_cast<unsigned int>(npcs.size()), templated);
+	printf("%-28s %13s %13s\n", "", "resolved", "chain walk");
+
+	Compare("IsEssential/Female, GetRace", [&npcs]() {
+		unsigned long long sum = 0;
+
+		for (const auto& npc : npcs)
+			sum += npc.IsEssential() + npc.IsFemale() * 2 + npc.GetRace() + npc.GetDeathItem();
+
+		return sum;
+	}, [&npcs]() {
+		unsigned long long sum = 0;
+
+		for (const auto& npc : npcs)
+		{
+			const DB::NPC* traits = Walk(&npc, Traits);
+			sum += Walk(&npc, Base)->IsEssential() + traits->IsFemale() * 2 + traits->GetRace() + traits->GetDeathItem();
+		}
+
+		return sum;
+	});
+
+	Compare("GetBaseContainer", [&npcs]() {
+		unsigned long long sum = 0;
+
+		for (const auto& npc : npcs)
+			sum += npc.GetBaseContainer().size();
+
+		return sum;
+	}, [&npcs]() {
+		unsigned long long sum = 0;
+
+		for (const auto& npc : npcs)
+			sum += DB::BaseContainer::Lookup(Walk(&npc, Inventory)->GetBase()).size();
+
+		return sum;
+	});
+}
+
+static void References()
+{
+	static const char* types[] = {"CONT", "DOOR", "TERM", "STAT"};
+	const auto& refs = DB::Reference::Get();
+	const auto& cells = DB::Reference::GetCells();
+
+	printf("\n%u references in %u cells\n", static_cast<unsigned int>(refs.size()), static_cast<unsigned int>(cells.size()));
+	printf("%-28s %13s %13s\n", "", "indexed", "scan");
+
+	// the scans collect into a new vector, like Lookup(type) did
+	Compare("Lookup(type), every type", []() {
+		unsigned long long sum = 0;
+
+		for (const char* type : types)
+			for (const auto* ref : DB::Reference::Lookup(type))
+				sum += ref->GetReference();
+
+		return sum;
+	}, [&refs]() {
+		unsigned long long sum = 0;
+
+		for (const char* type : types)
+		{
+			vector<DB::Reference*> result;
+			unsigned int code = DB::Record::FourCC(type);
+
+			for (const auto& ref : refs)
+				if (ref.second->GetTypeCode() == code)
+					result.emplace_back(ref.second);
+
+			for (const auto* ref : result)
+				sum += ref->GetReference();
+		}
+
+		return sum;
+	});
+
+	Compare("Lookup(cell, type), all cells", [&cells]() {
+		unsigned long long sum = 0;
+
+		for (const auto& cell : cells)
+			for (const char* type : types)
+				for (const auto* ref : DB::Reference::Lookup(cell.first, type))
+					sum += ref->GetReference();
+
+		return sum;
+	}, [&cells]() {
+		unsigned long long sum = 0;
+
+		for (const auto& cell : cells)
+			for (const char* type : types)
+			{
+				vector<DB::Reference*> result;
+				unsigned int code = DB::Record::FourCC(type);
+
+				for (auto* ref : cells.find(cell.first)->second)
+					if (ref->GetTypeCode() == code)
+						result.emplace_back(ref);
+
+				for (const auto* ref : result)
+					sum += ref->GetReference();
+			}
+
+		return sum;
+	});
+
+	// what a cell query cost before references were kept per cell
+	Compare("Lookup(cell, type), 100 cells", [&cells]() {
+		unsigned long long sum = 0;
+		auto cell = cells.begin();
+
+		for (unsigned int i = 0; i < 100 && cell != cells.end(); ++i, ++cell)
+			for (const auto* ref : DB::Reference::Lookup(cell->first, "CONT"))
+				sum += ref->GetReference();
+
+		return sum;
+	}, [&cells, &refs]() {
+		unsigned long long sum = 0;
+		unsigned int code = DB::Record::FourCC("CONT");
+		auto cell = cells.begin();
+
+		for (unsigned int i = 0; i < 100 && cell != cells.end(); ++i, ++cell)
+		{
+			vector<DB::Reference*> result;
+
+			for (const auto& ref : refs)
+				if (ref.second->GetCell() == cell->first && ref.second->GetTypeCode() == code)
+					result.emplace_back(ref.second);
+
+			for (const auto* ref : result)
+				sum += ref->GetReference();
+		}
+
+		return sum;
+	});
+}
+
+// the objects Script::LoadCell creates for a cell: every reference but statics, the first static only if there is none
+static unsigned int Residents(unsigned int cell, bool dlc)
+{
+	const auto& cells = DB::Reference::GetCells();
+	auto it = cells.find(cell);
+
+	if (it == cells.end())
+		return 0;
+
+	unsigned int count = 0;
+	bool anchor = false;
+
+	for (const auto* data : it->second)
+	{
+		if (!dlc && (data->GetReference() & 0xFF000000))
+			continue;
+
+		if (data->GetTypeCode() == DB::Record::FourCC("STAT"))
+			anchor = true;
+		else
+			++count;
+	}
+
+	return count ? count : anchor;
+}
+
+// Script::Initialize created every reference but statics, a static only if it came first in its cell
+static unsigned int Eager(bool dlc)
+{
+	unordered_set<unsigned int> refs_cells;
+	unsigned int count = 0;
+
+	for (const auto& cell : DB::Reference::GetCells())
+		refs_cells.emplace(cell.first);
+
+	for (const auto& reference : DB::Reference::Get())
+	{
+		if (!dlc && (reference.first & 0xFF000000))
+			continue;
+
+		unsigned int cell = reference.second->GetCell();
+
+		if (reference.second->GetTypeCode() != DB::Record::FourCC("STAT") || refs_cells.count(cell))
+			++count;
+
+		refs_cells.erase(cell);
+	}
+
+	return count;
+}
+
+// Script::LoadCells for a cell and the exterior cells adjacent to it
+static unsigned int Residents(unsigned int cell, bool dlc, unsigned int& loaded)
+{
+	auto exterior = DB::Exterior::Lookup(cell);
+	unsigned int count = 0;
+	loaded = 0;
+
+	for (unsigned int adjacent : exterior ? exterior->GetAdjacents() : array<unsigned int, 9>{{cell}})
+		if (adjacent)
+		{
+			count += Residents(adjacent, dlc);
+			++loaded;
+		}
+
+	return count;
+}
+
+static void Residents()
+{
+	const auto& cells = DB::Reference::GetCells();
+
+	// Vault101Exterior, the spawn cell of vaultserver.ini, and the cell with the most references
+	static const unsigned int spawn = 0x000010C1;
+	unsigned int densest = 0, most = 0;
+
+	for (const auto& cell : cells)
+		if (cell.second.size() > most)
+		{
+			densest = cell.first;
+			most = cell.second.size();
+		}
+
+	printf("\nobjects instantiated for %u persistent references, the server skips those of DLCs so far\n", static_cast<unsigned int>(DB::Reference::Get().size()));
+	printf("%-40s %13s %13s\n", "", "server", "with DLCs");
+
+	auto print = [](const string& name, unsigned int server, unsigned int dlc) {
+		printf("%-40s %13u %13u\n", name.c_str(), server, dlc);
+	};
+
+	print("at startup, before", Eager(false), Eager(true));
+	print("at startup, now", 0, 0);
+
+	char name[64];
+	unsigned int loaded, server, dlc;
+
+	for (unsigned int cell : {spawn, densest})
+	{
+		server = Residents(cell, false, loaded);
+		dlc = Residents(cell, true, loaded);
+		snprintf(name, sizeof(name), "first player in %08X, %u cells", cell, loaded);
+		print(name, server, dlc);
+	}
+
+	server = dlc = 0;
+
+	for (const auto& cell : cells)
+	{
+		server += Residents(cell.first, false);
+		dlc += Residents(cell.first, true);
+	}
+
+	print("every cell, " + to_string(cells.size()) + " cells", server, dlc);
+}
+
+static void Containers()
+{
+	static const unsigned int CONTAINERS = 10000;
+	vector<unsigned int> bases;
+
+	if (synthetic)
+		for (unsigned int i = 0; i < synthetic; ++i)
+			bases.emplace_back(0x00F00000 + i);
+	else
+	{
+		// the base containers of the CONT references, repeated until there are as many as a large world spawns
+		for (const auto* ref : DB::Reference::Lookup("CONT"))
+			bases.emplace_back(ref->GetBase());
+
+		for (size_t i = 0; !bases.empty() && bases.size() < CONTAINERS; ++i)
+			bases.emplace_back(bases[i]);
+
+		bases.resize(min<size_t>(bases.size(), CONTAINERS));
+	}
+
+	// the node based indexes Lookup used before, holding the same rows
+	unordered_map<unsigned int, vector<const DB::BaseContainer*>> containers;
+	unordered_map<unsigned int, const DB::Item*> items;
+
+	for (const auto& row : GameFactory::GetContainers())
+		if (!containers.count(row.GetBase()))
+		{
+			auto& rows = containers[row.GetBase()];
+
+			for (const auto* container : DB::BaseContainer::Lookup(row.GetBase()))
+				rows.emplace_back(container);
+		}
+
+	for (const auto& item : GameFactory::GetItems())
+		items.emplace(item.GetBase(), *DB::Item::Lookup(item.GetBase()));
+
+	unsigned int rows = 0;
+
+	for (unsigned int base : bases)
+		rows += DB::BaseContainer::Lookup(base).size();
+
+	printf("\n%u containers of %u bases with %u rows, %u items\n", static_cast<unsigned int>(bases.size()), static_cast<unsigned int>(unordered_set<unsigned int>(bases.begin(), bases.end()).size()), rows, static_cast<unsigned int>(items.size()));
+	printf("%-28s %13s %13s\n", "", "flat", "unordered_map");
+
+	// the lookups Script::AddItemList and the item creation do per container
+	Compare("populate containers", [&bases]() {
+		unsigned long long sum = 0;
+
+		for (unsigned int base : bases)
+			for (const auto* row : DB::BaseContainer::Lookup(base))
+			{
+				if (row->GetItem() & 0xFF000000)
+					continue;
+
+				auto item = DB::Item::Lookup(row->GetItem());
+				sum += row->GetCount() + (item ? item->GetValue() : 0);
+			}
+
+		return sum;
+	}, [&bases, &containers, &items]() {
+		unsigned long long sum = 0;
+
+		for (unsigned int base : bases)
+		{
+			auto rows = containers.find(base);
+
+			if (rows == containers.end())
+				continue;
+
+			for (const auto* row : rows->second)
+			{
+				if (row->GetItem() & 0xFF000000)
+					continue;
+
+				auto item = items.find(row->GetItem());
+				sum += row->GetCount() + (item != items.end() ? item->second->GetValue() : 0);
+			}
+		}
+
+		return sum;
+	});
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1)
+		directory = argv[1];
+
+	if (argc > 2)
+		rounds = max(atoi(argv[2]), 1);
+
+	if (argc > 3)
+		synthetic = strtoul(argv[3], nullptr, 10);
+
+	Import();
+	Startup();
+
+	try
+	{
+		GameFactory::Load();
+	}
+	catch (exception& e)
+	{
+		fprintf(stderr, "Could not load the database: %s\n", e.what());
+		return 1;
+	}
+
+	Templates();
+	References();
+	Residents();
+	Containers();
+	return 0;
+}
@@ -0,0 +1,418 @@
+/*
+ * Loopback load generator for the master server.
+ *
+ * usage: masterbench <servers> <clients> <qps> <seconds> [full|page|delta] [host[:port]]
+ *
+ * Connects <servers> peers which announce like dedicated servers do (three rules and two mod files, every two seconds),
+ * then <clients> peers which send <qps> ID_MASTER_QUERY in total for <seconds> and collect the replies:
+ *
+ * full   the query without payload, answered with every server
+ * page   a filtered query for the 50 servers with the most players, with the dictionary encoding (default)
+ * delta  a query for the servers changed since the generation of the previous reply
+ *
+ * Every server keeps a connection to the master, start it with enough connections for all peers, e.g. for
+ * 5000 servers and 8 clients: vaultmaster 30 5100
+ *
+ * Latency is measured from sending a query to receiving the next reply on the same connection. Replies are sent
+ * RELIABLE, so this assumes they arrive in order, which they do on loopback.
+ */
+
+#include "RakNet.hpp"
+#include "vaultmp.hpp"
+#include "Data.hpp"
+#include "ServerEntry.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+using namespace RakNet;
+
+typedef chrono::steady_clock Clock;
+
+enum Mode
+{
+	Full,
+	Page,
+	Delta,
+};
+
+// queries in flight per client before sending is skipped, keeps a saturated master from queueing without bound
+static const unsigned int MAX_OUTSTANDING = 4096;
+static const unsigned int ANNOUNCE_INTERVAL = 2000;
+// an idle RakPeer runs its update loop every 10 ms, which costs about 0.5 ms CPU per second and peer. the servers only
+// announce, so their update loop is held back to this interval, else a few thousand of them saturate a CPU on their own
+static const unsigned int SERVER_UPDATE_INTERVAL = 200;
+static const unsigned int SHUTDOWN_THREADS = 32;
+
+static string host = "127.0.0.1";
+static unsigned short port = 1660;
+
+struct Stats
+{
+	unsigned long long sent = 0;
+	unsigned long long skipped = 0;
+	unsigned long long answered = 0;
+	unsigned long long bytes = 0;
+	vector<double> latency;
+};
+
+static void Throttle(RakPeerInterface*, void*)
+{
+	this_thread::sleep_for(chrono::milliseconds(SERVER_UPDATE_INTERVAL));
+}
+
+static RakPeerInterface* Connect(bool server)
+{
+	RakPeerInterface* peer = RakPeerInterface::GetInstance();
+	SocketDescriptor sockdescr(0, 0);
+
+	if (server)
+		peer->SetUserUpdateThread(Throttle, nullptr);
+
+	if (peer->Startup(1, &sockdescr, 1) != RAKNET_STARTED || peer->Connect(host.c_str(), port, MASTER_VERSION, sizeof(MASTER_VERSION)) != CONNECTION_ATTEMPT_STARTED)
+	{
+		fprintf(stderr, "Could not start a peer\n");
+		exit(1);
+	}
+
+	return peer;
+}
+
+static bool Accepted(RakPeerInterface* peer, bool& failed)
+{
+	bool accepted = false;
+
+	for (Packet* packet = peer->Receive(); packet; peer->DeallocatePacket(packet), packet = peer->Receive())
+		switch (packet->data[0])
+		{
+			case ID_CONNECTION_REQUEST_ACCEPTED:
+				accepted = true;
+				break;
+
+			case ID_NO_FREE_INCOMING_CONNECTIONS:
+			case ID_CONNECTION_ATTEMPT_FAILED:
+			case ID_INVALID_PASSWORD:
+				failed = true;
+				break;
+		}
+
+	return accepted;
+}
+
+static void Announce(RakPeerInterface* peer, unsigned int i)
+{
+	BitStream query;
+	RakString name(("vaultmp server " + to_string(i)).c_str());
+	RakString map(i % 3 ? "the wasteland" : "dc");
+	static const char* rules[][2] = {{"website", "vaultmp.com"}, {"version", DEDICATED_VERSION}, {"gamemode", "freeroam"}};
+
+	query.Write(static_cast<MessageID>(ID_MASTER_ANNOUNCE));
+	query.Write(true);
+	query.Write(name);
+	query.Write(map);
+	query.Write(static_cast<unsigned int>(rand() % 33));
+	query.Write(32u);
+	query.Write(3u);
+
+	for (const auto& rule : rules)
+	{
+		RakString key(rule[0]), value(rule[1]);
+		query.Write(key);
+		query.Write(value);
+	}
+
+	RakString esm("Fallout3.esm"), dlc(i % 2 ? "Anchorage.esm" : "ThePitt.esm");
+	query.Write(2u);
+	query.Write(esm);
+	query.Write(dlc);
+
+	peer->Send(&query, HIGH_PRIORITY, RELIABLE_ORDERED, 0, peer->GetSystemAddressFromIndex(0), false);
+}
+
+static void Query(RakPeerInterface* peer, Mode mode, unsigned int generation)
+{
+	BitStream query;
+	query.Write(static_cast<MessageID>(ID_MASTER_QUERY));
+
+	if (mode != Full)
+	{
+		RakString empty("");
+		query.Write(mode == Delta ? generation : 0u);
+		query.Write(0u);
+		query.Write(mode == Page ? 50u : 0u);
+		query.Write(static_cast<unsigned char>(ServerQuery::SortPlayers));
+		query.Write(static_cast<unsigned char>(ServerQuery::Dictionary));
+		query.Write(empty);
+		query.Write(empty);
+		query.Write(0u);
+		query.Write(0u);
+	}
+
+	peer->Send(&query, HIGH_PRIORITY, RELIABLE_ORDERED, 0, peer->GetSystemAddressFromIndex(0), false);
+}
+
+// reads the generation and the total from a reply to a query with payload, skipping the servers
+static bool Trailer(Packet* packet, unsigned int& total, unsigned int& generation)
+{
+	BitStream reply(packet->data, packet->length, false);
+	reply.IgnoreBytes(sizeof(MessageID));
+
+	unsigned int size;
+	unsigned short strings;
+	reply.Read(size);
+	reply.Read(strings);
+
+	for (unsigned int i = 0; i < strings; ++i)
+	{
+		RakString str;
+		reply.Read(str);
+	}
+
+	for (unsigned int i = 0; i < size; ++i)
+	{
+		SystemAddress addr;
+		RakString name, map;
+		unsigned int players, playersMax;
+		unsigned short count, index;
+
+		reply.Read(addr);
+		reply.Read(name);
+		reply.Read(map);
+		reply.Read(players);
+		reply.Read(playersMax);
+		reply.Read(count);
+
+		for (unsigned int j = 0; j < count * 2u; ++j)
+			reply.Read(index);
+
+		reply.Read(count);
+
+		for (unsigned int j = 0; j < count; ++j)
+			reply.Read(index);
+	}
+
+	bool reset;
+	return reply.Read(total) && reply.Read(generation) && reply.Read(reset);
+}
+
+static void Client(RakPeerInterface* peer, Mode mode, double qps, Clock::time_point end, Stats& stats)
+{
+	auto interval = chrono::duration_cast<Clock::duration>(chrono::duration<double>(1.0 / qps));
+	auto next = Clock::now();
+	deque<Clock::time_point> outstanding;
+	unsigned int generation = 0, total;
+
+	while (Clock::now() < end || (!outstanding.empty() && Clock::now() < end + chrono::seconds(5)))
+	{
+		auto now = Clock::now();
+
+		for (; now < end && next <= now; next += interval)
+			if (outstanding.size() < MAX_OUTSTANDING)
+			{
+				Query(peer, mode, generation);
+				outstanding.emplace_back(now);
+				++stats.sent;
+			}
+			else
+				++stats.skipped;
+
+		for (Packet* packet = peer->Receive(); packet; peer->DeallocatePacket(packet), packet = peer->Receive())
+			if (packet->data[0] == ID_MASTER_QUERY && !outstanding.empty())
+			{
+				stats.latency.emplace_back(chrono::duration<double, milli>(Clock::now() - outstanding.front()).count());
+				stats.bytes += packet->length;
+				++stats.answered;
+				outstanding.pop_front();
+
+				if (mode == Delta)
+					Trailer(packet, total, generation);
+			}
+
+		this_thread::sleep_for(chrono::milliseconds(1));
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 5)
+	{
+		fprintf(stderr, "usage: %s <servers> <clients> <qps> <seconds> [full|page|delta] [host[:port]]\n", argv[0]);
+		return 1;
+	}
+
+	unsigned int servers = strtoul(argv[1], nullptr, 10);
+	unsigned int clients = max(strtoul(argv[2], nullptr, 10), 1ul);
+	double qps = max(atof(argv[3]), 1.0);
+	unsigned int seconds = strtoul(argv[4], nullptr, 10);
+	string mode_ = argc > 5 ? argv[5] : "page";
+	Mode mode = mode_ == "full" ? Full : mode_ == "delta" ? Delta : Page;
+
+	if (argc > 6)
+	{
+		host = argv[6];
+		size_t colon = host.find(':');
+
+		if (colon != string::npos)
+		{
+			port = atoi(host.c_str() + colon + 1);
+			host.erase(colon);
+		}
+	}
+
+	vector<RakPeerInterface*> peers;
+	vector<bool> connected(servers);
+	unsigned int count = 0;
+	bool failed = false;
+	auto start = Clock::now();
+
+	// connected in batches, the master drops connection attempts it can't process in time
+	for (unsigned int i = 0; i < servers && !failed; i += 100)
+	{
+		for (unsigned int j = i; j < min(i + 100, servers); ++j)
+			peers.emplace_back(Connect(true));
+
+		while (count < peers.size() && !failed && Clock::now() - start < chrono::seconds(60 + servers / 50))
+		{
+			for (unsigned int j = 0; j < peers.size(); ++j)
+				if (!connected[j] && Accepted(peers[j], failed))
+				{
+					connected[j] = true;
+					Announce(peers[j], j);
+					++count;
+				}
+
+			this_thread::sleep_for(chrono::milliseconds(5));
+		}
+	}
+
+	if (count < servers)
+	{
+		fprintf(stderr, "Only %u of %u servers could connect, does the master accept enough connections?\n", count, servers);
+		return 1;
+	}
+
+	printf("%u servers connected and announced in %.1f s\n", servers, chrono::duration<double>(Clock::now() - start).count());
+
+	atomic<bool> running(true);
+
+	// servers keep announcing, so the master keeps publishing new registries while it answers queries
+	thread announcer([&peers, &running]() {
+		while (running)
+		{
+			auto round = Clock::now();
+
+			for (unsigned int i = 0; i < peers.size() && running; ++i)
+			{
+				Announce(peers[i], i);
+
+				for (Packet* packet = peers[i]->Receive(); packet; packet = peers[i]->Receive())
+					peers[i]->DeallocatePacket(packet);
+			}
+
+			this_thread::sleep_until(round + chrono::milliseconds(ANNOUNCE_INTERVAL));
+		}
+	});
+
+	vector<RakPeerInterface*> queriers;
+
+	for (unsigned int i = 0; i < clients; ++i)
+	{
+		queriers.emplace_back(Connect(false));
+
+		while (!Accepted(queriers.back(), failed))
+		{
+			if (failed)
+			{
+				fprintf(stderr, "A client could not connect, does the master accept enough connections?\n");
+				return 1;
+			}
+
+			this_thread::sleep_for(chrono::milliseconds(5));
+		}
+	}
+
+	// waits until the published registry lists every server
+	{
+		unsigned int total = 0, generation = 0;
+		auto deadline = Clock::now() + chrono::seconds(10);
+
+		while (total < servers && Clock::now() < deadline)
+		{
+			Query(queriers[0], Page, 0);
+			this_thread::sleep_for(chrono::milliseconds(100));
+
+			for (Packet* packet = queriers[0]->Receive(); packet; queriers[0]->DeallocatePacket(packet), packet = queriers[0]->Receive())
+				if (packet->data[0] == ID_MASTER_QUERY)
+					Trailer(packet, total, generation);
+		}
+
+		printf("master lists %u servers\n", total);
+	}
+
+	vector<Stats> stats(clients);
+	vector<thread> threads;
+	auto end = Clock::now() + chrono::seconds(seconds);
+	start = Clock::now();
+
+	for (unsigned int i = 0; i < clients; ++i)
+		threads.emplace_back(Client, queriers[i], mode, qps / clients, end, ref(stats[i]));
+
+	for (auto& thread : threads)
+		thread.join();
+
+	running = false;
+	announcer.join();
+
+	Stats result;
+
+	for (auto& client : stats)
+	{
+		result.sent += client.sent;
+		result.skipped += client.skipped;
+		result.answered += client.answered;
+		result.bytes += client.bytes;
+		result.latency.insert(result.latency.end(), client.latency.begin(), client.latency.end());
+	}
+
+	sort(result.latency.begin(), result.latency.end());
+
+	auto percentile = [&result](double p) { return result.latency.empty() ? 0.0 : result.latency[min(result.latency.size() - 1, static_cast<size_t>(p * result.latency.size()))]; };
+
+	printf("%s queries: %llu sent, %llu skipped, %llu answered, %.0f answered/s, %.0f bytes per reply\n", mode_.c_str(), result.sent, result.skipped, result.answered,
+		result.answered / static_cast<double>(seconds ? seconds : 1), result.answered ? result.bytes / static_cast<double>(result.answered) : 0.0);
+	printf("latency ms: p50 %.2f, p90 %.2f, p99 %.2f, max %.2f\n", percentile(0.5), percentile(0.9), percentile(0.99), result.latency.empty() ? 0.0 : result.latency.back());
+
+	// disconnects every peer before shutting down, else the master keeps their connections until they time out
+	peers.insert(peers.end(), queriers.begin(), queriers.end());
+
+	for (auto* peer : peers)
+		peer->CloseConnection(peer->GetSystemAddressFromIndex(0), true);
+
+	this_thread::sleep_for(chrono::milliseconds(500));
+
+	// a shutdown waits for the threads of its peer, one after another this takes minutes for thousands of servers
+	vector<thread> closers;
+
+	for (unsigned int i = 0; i < SHUTDOWN_THREADS; ++i)
+		closers.emplace_back([&peers, i]() {
+			for (size_t j = i; j < peers.size(); j += SHUTDOWN_THREADS)
+			{
+				peers[j]->Shutdown(0);
+				RakPeerInterface::DestroyInstance(peers[j]);
+			}
+		});
+
+	for (auto& closer : closers)
+		closer.join();
+
+	return 0;
+}
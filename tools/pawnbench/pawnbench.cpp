@@ -0,0 +1,251 @@
+/*
+ * Models the PAWN call paths of the server before and after callbacks were cached and native strings arena-allocated.
+ *
+ * usage: pawnbench <script.amx> [calls]
+ *
+ * PAWN.cpp can't be linked on its own, it needs Script and through it the network packet sources. This links the
+ * abstract machine as the server builds it and repeats the parts of PAWN.cpp that changed, once as they were and once
+ * as they are, on a compiled script:
+ *
+ * public  OnClientAuthenticate(name, pwd) called through PAWN::Call, which looked the public up by name on every call
+ *         before and goes through the CallStub cache now
+ * native  a string argument extracted for a native and released after the call, into a vector<char> of its own
+ *         before and from the StringArena now
+ */
+
+#include "amx/amx.h"
+#include "amx/amxaux.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <unordered_map>
+
+#include "Utils.hpp"
+
+using namespace std;
+
+static cell AMX_NATIVE_CALL stub(AMX*, const cell*)
+{
+	return 0;
+}
+
+class StringArena
+{
+	private:
+		static constexpr size_t BLOCK_SIZE = 4096;
+
+		vector<vector<char>> blocks;
+		size_t block = 0;
+		size_t used = 0;
+
+	public:
+		char* allocate(size_t size) noexcept
+		{
+			while (block < blocks.size() && used + size > blocks[block].size())
+			{
+				++block;
+				used = 0;
+			}
+
+			if (block == blocks.size())
+			{
+				size_t length = size > BLOCK_SIZE ? size : BLOCK_SIZE;
+				blocks.emplace_back(length);
+				used = 0;
+			}
+
+			char* value = &blocks[block][used];
+			used += size;
+			return value;
+		}
+
+		void reset() noexcept
+		{
+			block = 0;
+			used = 0;
+		}
+};
+
+struct CallStub
+{
+	string name;
+	string argl;
+	int index;
+	unsigned int strings;
+};
+
+static unordered_map<AMX*, unordered_map<unsigned long long, CallStub>> stubs;
+
+static const CallStub& Stub(AMX* amx, const char* name, const char* argl)
+{
+	unsigned long long key = (static_cast<unsigned long long>(Utils::hash(name, strlen(name) + 1)) << 32) | Utils::hash(argl, strlen(argl) + 1);
+	auto& stub = stubs[amx][key];
+
+	if (!stub.name.compare(name) && !stub.argl.compare(argl))
+		return stub;
+
+	int idx = 0;
+
+	if (amx_FindPublic(amx, name, &idx) != AMX_ERR_NONE)
+		abort();
+
+	stub.name = name;
+	stub.argl = argl;
+	stub.index = idx;
+	stub.strings = 0;
+
+	for (const char* type = argl; *type; ++type)
+		stub.strings += *type == 's';
+
+	return stub;
+}
+
+// both strings are pushed as PAWN::Call pushes them, the lookup of the public is what differs
+static cell Call(AMX* amx, const char* name, const char* argl, bool cached, const char* first, const char* second)
+{
+	int idx = 0;
+	unsigned int len;
+	vector<pair<cell*, const char*>> strings;
+
+	if (cached)
+	{
+		const CallStub& stub = Stub(amx, name, argl);
+		idx = stub.index;
+		len = stub.argl.length();
+		strings.reserve(stub.strings);
+	}
+	else
+	{
+		if (amx_FindPublic(amx, name, &idx) != AMX_ERR_NONE)
+			abort();
+
+		len = strlen(argl);
+	}
+
+	const char* values[] = {first, second};
+
+	for (unsigned int i = len; i; --i)
+	{
+		cell* store;
+		amx_PushString(amx, &store, values[i - 1], 1, 0);
+		strings.emplace_back(store, values[i - 1]);
+	}
+
+	cell ret = 0;
+
+	if (amx_Exec(amx, &ret, idx) != AMX_ERR_NONE)
+		abort();
+
+	if (!strings.empty())
+		amx_Release(amx, strings[0].first);
+
+	return ret;
+}
+
+static vector<vector<char>> vectors;
+static StringArena arena;
+
+// PAWN_extract_<const char*> and free_strings, the native itself only looks at the string
+static size_t Native(AMX* amx, const cell* params, bool cached)
+{
+	int len;
+	cell* source = amx_Address(amx, params[1]);
+	amx_StrLen(source, &len);
+
+	char* value;
+
+	if (cached)
+		value = arena.allocate(len + 1);
+	else
+	{
+		vectors.emplace_back(len + 1);
+		value = &vectors.back()[0];
+	}
+
+	amx_GetString(value, source, 0, UNLIMITED);
+	size_t result = strlen(value);
+
+	if (cached)
+		arena.reset();
+	else
+		vectors.clear();
+
+	return result;
+}
+
+template<typename F>
+static double Time(unsigned int calls, F function, unsigned long long& result)
+{
+	result = 0;
+	auto start = chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < calls; ++i)
+		result += function();
+
+	return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / calls;
+}
+
+template<typename F>
+static void Compare(const char* name, unsigned int calls, F function)
+{
+	unsigned long long a, b;
+	double before = Time(calls, [&function]() { return function(false); }, a);
+	double after = Time(calls, [&function]() { return function(true); }, b);
+
+	printf("%-34s %10.1f ns %10.1f ns %8.2fx %s\n", name, before, after, after > 0.0 ? before / after : 0.0, a == b ? "" : "RESULTS DIFFER");
+}
+
+int main(int argc, char* argv[])
+{
+	AMX amx;
+	int err, count;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: %s script.amx [calls]\n", argv[0]);
+		return 1;
+	}
+
+	unsigned int calls = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1000000;
+
+	if ((err = aux_LoadProgram(&amx, argv[1], nullptr)) != AMX_ERR_NONE)
+	{
+		fprintf(stderr, "could not load %s: %s\n", argv[1], aux_StrError(err));
+		return 1;
+	}
+
+	amx_NumNatives(&amx, &count);
+
+	for (int i = 0; i < count; ++i)
+	{
+		char name[sNAMEMAX + 1];
+		amx_GetNative(&amx, i, name);
+		AMX_NATIVE_INFO native[2] = {{name, stub}, {nullptr, nullptr}};
+		amx_Register(&amx, native, 1);
+	}
+
+	// the native reads its argument from the heap of the script, the core hands natives physical addresses
+	const char* text = "a player name of some length";
+	cell* physical;
+	amx_Allot(&amx, strlen(text) + 1, &physical);
+	amx_SetString(physical, text, 1, 0, UNLIMITED);
+	cell params[] = {sizeof(cell), reinterpret_cast<cell>(physical)};
+
+	printf("%u calls each\n", calls);
+	printf("%-34s %13s %13s\n", "", "before", "after");
+
+	Compare("public OnClientAuthenticate(s, s)", calls, [&amx](bool cached) {
+		return static_cast<unsigned long long>(Call(&amx, "OnClientAuthenticate", "ss", cached, "name", "password"));
+	});
+
+	Compare("native with a string argument", calls, [&amx, &params](bool cached) {
+		return static_cast<unsigned long long>(Native(&amx, params, cached));
+	});
+
+	aux_FreeProgram(&amx);
+	return 0;
+}